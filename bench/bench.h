@@ -0,0 +1,24 @@
+/**
+ * @file bench.h
+ * @brief Helpers shared by the benchmarks in bench/
+ * @author Robkoo
+ * @date 18.10.2026
+ * @version 0.0.3
+ * @since 0.0.3
+ */
+
+#ifndef RMA_BENCH
+#define RMA_BENCH
+
+#include <time.h>
+
+/**
+ * @brief Current monotonic time in nanoseconds
+ */
+static inline double benchNow(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+#endif // RMA_BENCH
@@ -0,0 +1,132 @@
+/**
+ * @file benchClone.c
+ * @brief Benchmark of rma_clone() against malloc() plus a full memcpy()
+ * @author Robkoo
+ * @date 18.10.2026
+ * @version 0.0.3
+ * @since 0.0.3
+ *
+ * Fills a pool to several occupancy levels with a random allocation
+ * pattern and compares the time to duplicate it with rma_clone() (copies
+ * only allocated runs) against the naive malloc(totalSize) + memcpy().
+ * Also verifies that a handle resolves to identical data in the clone.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include "memHeader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Size of the benchmarked pool
+ */
+#define BENCH_POOL_SIZE (64u * 1024 * 1024) // 64 MiB
+
+/**
+ * @brief Block size of the benchmarked pool
+ */
+#define BENCH_BLOCK_SIZE 4096
+
+/**
+ * @brief Number of timed repetitions per measurement (best one is reported)
+ */
+#define BENCH_REPEATS 5
+
+/**
+ * @brief Fill a fresh pool to the given occupancy, then free random blocks
+ * @return The filled pool, or NULL on failure
+ *
+ * Allocating everything and freeing a random subset produces the
+ * interleaved allocated/free runs a long-running service ends up with.
+ */
+static struct rma_mem_header_t* benchFillPool(unsigned occupancyPercent, rma_handle_t *sample){
+    struct rma_mem_header_t *pool = rma_memHeaderInit(BENCH_POOL_SIZE, BENCH_BLOCK_SIZE);
+    if (!pool) return NULL;
+
+    size_t const numBlocks = pool->numBlocks;
+    rma_handle_t *handles = malloc(numBlocks * sizeof(rma_handle_t));
+    if (!handles){
+        rma_destroy(pool);
+        return NULL;
+    }
+
+    // a failed allocation leaves a hole instead of writing through NULL
+    for (size_t i = 0; i < numBlocks; i++){
+        handles[i] = rma_alloc(pool);
+        void *block = rma_getPtr(pool, handles[i]);
+        if (block) memset(block, (int)(i & 0xFF), BENCH_BLOCK_SIZE);
+    }
+
+    *sample = RMA_INVALID_HANDLE;
+    for (size_t i = 0; i < numBlocks; i++){
+        if ((unsigned)(rand() % 100) >= occupancyPercent) rma_free(pool, handles[i]);
+        else if (*sample == RMA_INVALID_HANDLE) *sample = handles[i];
+    }
+
+    free(handles);
+    return pool;
+}
+
+/**
+ * @brief Entry point of the clone benchmark
+ * @return 0 on success, 1 on failure
+ */
+int main(void){
+    srand(42);
+
+    unsigned const occupancies[] = {10, 50, 90, 100};
+
+    printf("Pool: %u MiB, %u byte blocks, best of %d runs\n\n", BENCH_POOL_SIZE >> 20, BENCH_BLOCK_SIZE, BENCH_REPEATS);
+    printf("%10s %16s %16s %10s %10s\n", "occupancy", "rma_clone (ms)", "memcpy (ms)", "speedup", "verified");
+
+    for (size_t o = 0; o < sizeof(occupancies) / sizeof(occupancies[0]); o++){
+        rma_handle_t sample;
+        struct rma_mem_header_t *pool = benchFillPool(occupancies[o], &sample);
+        if (!pool){
+            fprintf(stderr, "pool setup failed\n");
+            return 1;
+        }
+
+        double bestClone = 1e18, bestCopy = 1e18;
+        int verified = 1;
+
+        for (int r = 0; r < BENCH_REPEATS; r++){
+            double start = benchNow();
+            struct rma_mem_header_t *clone = rma_clone(pool);
+            double const cloneNs = benchNow() - start;
+
+            start = benchNow();
+            void *copy = malloc(pool->totalSize);
+            if (copy) memcpy(copy, pool, pool->totalSize);
+            double const copyNs = benchNow() - start;
+
+            if (!clone || !copy){
+                fprintf(stderr, "allocation failed\n");
+                return 1;
+            }
+
+            // the same handle must resolve to the same bytes in the clone
+            if (sample != RMA_INVALID_HANDLE &&
+                memcmp(rma_getPtr(pool, sample), rma_getPtr(clone, sample), BENCH_BLOCK_SIZE) != 0){
+                verified = 0;
+            }
+
+            if (cloneNs < bestClone) bestClone = cloneNs;
+            if (copyNs < bestCopy) bestCopy = copyNs;
+
+            rma_destroy(clone);
+            free(copy);
+        }
+
+        printf("%9u%% %16.3f %16.3f %9.2fx %10s\n", occupancies[o], bestClone / 1e6, bestCopy / 1e6,
+               bestCopy / bestClone, verified ? "yes" : "NO");
+
+        rma_destroy(pool);
+    }
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file benchColoring.c
+ * @brief Benchmark of cache-colored block placement
+ * @author Robkoo
+ * @date 18.10.2026
+ * @version 0.0.3
+ * @since 0.0.3
+ *
+ * Stores a small header in the first cache line of many 4 KiB blocks and
+ * repeatedly walks all of them, the access pattern of an index scan over
+ * block-sized records. Without coloring every header maps to the same
+ * L1/L2 sets and the walk thrashes them; options.coloring staggers the
+ * block starts so the headers spread over all sets.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include "memHeader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Block size of the benchmarked pools (the problematic power of two)
+ */
+#define BENCH_BLOCK_SIZE 4096
+
+/**
+ * @brief Block counts whose headers are walked
+ */
+#define BENCH_MAX_BLOCKS 1024
+
+/**
+ * @brief Walks over all headers per measurement
+ */
+#define BENCH_PASSES 2000
+
+/**
+ * @brief Number of timed repetitions per measurement (best one is reported)
+ */
+#define BENCH_REPEATS 5
+
+/**
+ * @brief Record header kept at the start of every block
+ */
+struct bench_record_t {
+    uint64_t key;     /**< Record key */
+    uint64_t hits;    /**< Updated on every visit */
+};
+
+/**
+ * @brief Time one header walk over a pool
+ * @param coloring Value of options.coloring
+ * @param numBlocks Number of blocks to walk
+ * @param stride Output: the pool's block stride
+ * @return Best time per visited header in nanoseconds, or a negative value on failure
+ */
+static double benchWalk(int coloring, size_t numBlocks, size_t *stride){
+    struct rma_options_t const options = { .coloring = coloring, .alignment = 64 };
+    size_t const totalSize = rma_poolSizeForBlocks(numBlocks, BENCH_BLOCK_SIZE, &options);
+    struct rma_mem_header_t *pool = rma_memHeaderInitEx(totalSize, BENCH_BLOCK_SIZE, &options);
+    if (pool == NULL) return -1.0;
+    *stride = pool->blockStride;
+
+    struct bench_record_t **records = malloc(numBlocks * sizeof(*records));
+    if (records == NULL) return -1.0;
+    for (size_t i = 0; i < numBlocks; i++){
+        records[i] = rma_getPtr(pool, rma_alloc(pool));
+        records[i]->key = i;
+        records[i]->hits = 0;
+    }
+
+    double best = 1e18;
+    uint64_t checksum = 0;
+    for (int r = 0; r < BENCH_REPEATS; r++){
+        double const start = benchNow();
+        for (int pass = 0; pass < BENCH_PASSES; pass++){
+            for (size_t i = 0; i < numBlocks; i++){
+                records[i]->hits++;
+                checksum += records[i]->key;
+            }
+        }
+        double const elapsed = benchNow() - start;
+        if (elapsed < best) best = elapsed;
+    }
+
+    // keep the walk from being optimized away
+    if (checksum == 1) printf(" ");
+
+    free(records);
+    rma_destroy(pool);
+    return best / ((double)BENCH_PASSES * (double)numBlocks);
+}
+
+/**
+ * @brief Entry point of the coloring benchmark
+ * @return 0 on success, 1 on failure
+ */
+int main(void){
+    printf("Block size: %u bytes, %d passes, best of %d runs\n\n", BENCH_BLOCK_SIZE, BENCH_PASSES, BENCH_REPEATS);
+    printf("%8s %14s %14s %16s %16s %10s\n", "blocks", "plain stride", "color stride", "plain (ns/hdr)", "color (ns/hdr)", "speedup");
+
+    for (size_t numBlocks = 16; numBlocks <= BENCH_MAX_BLOCKS; numBlocks *= 2){
+        size_t plainStride = 0, colorStride = 0;
+        double const plain = benchWalk(0, numBlocks, &plainStride);
+        double const colored = benchWalk(1, numBlocks, &colorStride);
+        if (plain < 0 || colored < 0){
+            fprintf(stderr, "pool setup failed\n");
+            return 1;
+        }
+
+        printf("%8zu %14zu %14zu %16.2f %16.2f %9.2fx\n", numBlocks, plainStride, colorStride, plain, colored, plain / colored);
+    }
+
+    return 0;
+}
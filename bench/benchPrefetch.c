@@ -0,0 +1,150 @@
+/**
+ * @file benchPrefetch.c
+ * @brief Benchmark of the prefetch API on a random-access workload
+ * @author Robkoo
+ * @date 18.10.2026
+ * @version 0.0.3
+ * @since 0.0.3
+ *
+ * Visits a random permutation of pool blocks, as a hash table or graph
+ * traversal would, and compares plain rma_getPtr() with
+ * rma_getPtrPrefetchNext() (the next handle of the sequence is known one
+ * step ahead). A second measurement gathers random batches of handles with
+ * rma_getPtr() per handle and with a single rma_prefetchBatch() call.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include "memHeader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Size of the benchmarked pool
+ */
+#define BENCH_POOL_SIZE (2u * 1024 * 1024) // 2 MiB, stays well below the 16-bit salt space
+
+/**
+ * @brief Block size of the benchmarked pool
+ */
+#define BENCH_BLOCK_SIZE 256
+
+/**
+ * @brief Number of handles gathered per batch
+ */
+#define BENCH_BATCH 256
+
+/**
+ * @brief Number of timed repetitions per measurement (best one is reported)
+ */
+#define BENCH_REPEATS 3
+
+/**
+ * @brief Visit every handle of the sequence with rma_getPtr()
+ */
+static uint64_t benchVisitPlain(struct rma_mem_header_t *pool, rma_handle_t const *sequence, size_t length){
+    uint64_t sum = 0;
+    for (size_t i = 0; i < length; i++) sum += *(uint32_t const*)rma_getPtr(pool, sequence[i]);
+    return sum;
+}
+
+/**
+ * @brief Visit every handle of the sequence, prefetching the following one
+ */
+static uint64_t benchVisitPrefetch(struct rma_mem_header_t *pool, rma_handle_t const *sequence, size_t length){
+    uint64_t sum = 0;
+    for (size_t i = 0; i < length; i++){
+        rma_handle_t const next = i + 1 < length ? sequence[i + 1] : RMA_INVALID_HANDLE;
+        sum += *(uint32_t const*)rma_getPtrPrefetchNext(pool, sequence[i], next);
+    }
+    return sum;
+}
+
+/**
+ * @brief Entry point of the prefetch benchmark
+ * @return 0 on success, 1 on failure
+ */
+int main(void){
+    srand(42);
+
+    struct rma_mem_header_t *pool = rma_memHeaderInit(BENCH_POOL_SIZE, BENCH_BLOCK_SIZE);
+    if (!pool){
+        fprintf(stderr, "pool setup failed\n");
+        return 1;
+    }
+
+    // visit a random subset of the blocks in random order
+    size_t const length = pool->numBlocks / 4;
+    rma_handle_t *handles = malloc(pool->numBlocks * sizeof(rma_handle_t));
+    if (!handles) return 1;
+
+    for (size_t i = 0; i < pool->numBlocks; i++){
+        handles[i] = rma_alloc(pool);
+        *(uint32_t*)rma_getPtr(pool, handles[i]) = (uint32_t)i;
+    }
+    for (size_t i = pool->numBlocks - 1; i > 0; i--){
+        size_t const j = (size_t)rand() % (i + 1);
+        rma_handle_t const swap = handles[i];
+        handles[i] = handles[j];
+        handles[j] = swap;
+    }
+
+    printf("Pool: %u KiB, %u byte blocks, %zu random visits, best of %d runs\n\n",
+           BENCH_POOL_SIZE >> 10, BENCH_BLOCK_SIZE, length, BENCH_REPEATS);
+
+    double bestPlain = 1e18, bestPrefetch = 1e18;
+    uint64_t sumPlain = 0, sumPrefetch = 0;
+
+    for (int r = 0; r < BENCH_REPEATS; r++){
+        double start = benchNow();
+        sumPlain = benchVisitPlain(pool, handles, length);
+        double const plainNs = benchNow() - start;
+
+        start = benchNow();
+        sumPrefetch = benchVisitPrefetch(pool, handles, length);
+        double const prefetchNs = benchNow() - start;
+
+        if (plainNs < bestPlain) bestPlain = plainNs;
+        if (prefetchNs < bestPrefetch) bestPrefetch = prefetchNs;
+    }
+
+    printf("%-28s %14s %10s\n", "workload", "time (ms)", "speedup");
+    printf("%-28s %14.3f %10s\n", "random visit, rma_getPtr", bestPlain / 1e6, "1.00x");
+    printf("%-28s %14.3f %9.2fx %s\n", "random visit, prefetch next", bestPrefetch / 1e6, bestPlain / bestPrefetch,
+           sumPlain == sumPrefetch ? "" : "(MISMATCH)");
+
+    // random gather: one resolution pass per handle vs one per batch
+    rma_handle_t batch[BENCH_BATCH];
+    void *ptrs[BENCH_BATCH];
+    for (size_t i = 0; i < BENCH_BATCH; i++) batch[i] = handles[(size_t)rand() % pool->numBlocks];
+
+    double bestSingle = 1e18, bestBatch = 1e18;
+    uint64_t sumSingle = 0, sumBatch = 0;
+
+    for (int r = 0; r < BENCH_REPEATS; r++){
+        double start = benchNow();
+        sumSingle = 0;
+        for (size_t i = 0; i < BENCH_BATCH; i++) sumSingle += *(uint32_t const*)rma_getPtr(pool, batch[i]);
+        double const singleNs = benchNow() - start;
+
+        start = benchNow();
+        sumBatch = 0;
+        rma_prefetchBatch(pool, batch, BENCH_BATCH, ptrs, RMA_PREFETCH_READ, 3);
+        for (size_t i = 0; i < BENCH_BATCH; i++) sumBatch += *(uint32_t const*)ptrs[i];
+        double const batchNs = benchNow() - start;
+
+        if (singleNs < bestSingle) bestSingle = singleNs;
+        if (batchNs < bestBatch) bestBatch = batchNs;
+    }
+
+    printf("%-28s %14.3f %10s\n", "gather, rma_getPtr", bestSingle / 1e6, "1.00x");
+    printf("%-28s %14.3f %9.2fx %s\n", "gather, rma_prefetchBatch", bestBatch / 1e6, bestSingle / bestBatch,
+           sumSingle == sumBatch ? "" : "(MISMATCH)");
+
+    free(handles);
+    rma_destroy(pool);
+    return 0;
+}
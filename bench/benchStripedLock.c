@@ -0,0 +1,189 @@
+/**
+ * @file benchStripedLock.c
+ * @brief Benchmark of rma_lock() stripes against one pthread mutex per object
+ * @author Robkoo
+ * @date 18.10.2026
+ * @version 0.0.3
+ * @since 0.0.3
+ *
+ * Several threads increment counters in randomly chosen blocks, each
+ * update guarded either by the caller's own mutex array (one
+ * pthread_mutex_t per object, indexed by a side table) or by rma_lock()
+ * with a few stripe counts. Reports time per update, memory spent on
+ * locks and the contention rma_getStats() saw.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include "memHeader.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief Number of objects (blocks) updated
+ */
+#define BENCH_OBJECTS 4096
+
+/**
+ * @brief Block size of the benchmarked pool
+ */
+#define BENCH_BLOCK_SIZE 64
+
+/**
+ * @brief Worker threads
+ */
+#define BENCH_THREADS 4
+
+/**
+ * @brief Updates per thread and measurement
+ */
+#define BENCH_UPDATES 1000000
+
+/**
+ * @brief Number of timed repetitions per measurement (best one is reported)
+ */
+#define BENCH_REPEATS 3
+
+/**
+ * @brief Shared state of one measurement
+ */
+struct bench_run_t {
+    struct rma_mem_header_t *pool;  /**< Pool holding the objects */
+    rma_handle_t *handles;          /**< Handle of every object */
+    unsigned long **objects;        /**< Resolved block of every object */
+    pthread_mutex_t *mutexes;       /**< One mutex per object, or NULL to use rma_lock() */
+};
+
+/**
+ * @brief Arguments of one worker thread
+ */
+struct bench_worker_t {
+    struct bench_run_t const *run;  /**< Measurement the worker belongs to */
+    unsigned seed;                  /**< Seed of the worker's object sequence */
+};
+
+/**
+ * @brief Worker: increment random objects under the configured lock
+ * @param argument Pointer to struct bench_worker_t
+ * @return NULL
+ */
+static void* benchWorker(void *argument){
+    struct bench_worker_t *worker = argument;
+    struct bench_run_t const *run = worker->run;
+    uint32_t state = worker->seed;
+
+    for (int i = 0; i < BENCH_UPDATES; i++){
+        // xorshift keeps the object choice cheap next to the lock
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        size_t const object = state % BENCH_OBJECTS;
+
+        if (run->mutexes){
+            pthread_mutex_lock(&run->mutexes[object]);
+            run->objects[object][0]++;
+            pthread_mutex_unlock(&run->mutexes[object]);
+        }
+        else {
+            rma_lock(run->pool, run->handles[object]);
+            run->objects[object][0]++;
+            rma_unlock(run->pool, run->handles[object]);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Time all workers over one lock configuration
+ * @param run Measurement state
+ * @return Best time per update in nanoseconds
+ */
+static double benchRun(struct bench_run_t const *run){
+    double best = 1e18;
+
+    for (int r = 0; r < BENCH_REPEATS; r++){
+        pthread_t threads[BENCH_THREADS];
+        struct bench_worker_t workers[BENCH_THREADS];
+
+        double const start = benchNow();
+        for (int t = 0; t < BENCH_THREADS; t++){
+            workers[t] = (struct bench_worker_t){ run, 2463534242u + (unsigned)t * 7919u };
+            pthread_create(&threads[t], NULL, benchWorker, &workers[t]);
+        }
+        for (int t = 0; t < BENCH_THREADS; t++) pthread_join(threads[t], NULL);
+
+        double const elapsed = benchNow() - start;
+        if (elapsed < best) best = elapsed;
+    }
+
+    return best / ((double)BENCH_THREADS * BENCH_UPDATES);
+}
+
+/**
+ * @brief Build a pool with the given stripe count and fill it with objects
+ * @param lockStripes Value of options.lockStripes
+ * @param run Output: measurement state (handles and objects must be allocated)
+ * @return 1 on success, 0 on failure
+ */
+static int benchSetup(size_t lockStripes, struct bench_run_t *run){
+    struct rma_options_t const options = { .lockStripes = lockStripes };
+    run->pool = rma_memHeaderInitEx(rma_poolSizeForBlocks(BENCH_OBJECTS, BENCH_BLOCK_SIZE, &options), BENCH_BLOCK_SIZE, &options);
+    if (run->pool == NULL) return 0;
+
+    for (size_t i = 0; i < BENCH_OBJECTS; i++){
+        run->handles[i] = rma_alloc(run->pool);
+        run->objects[i] = rma_getPtr(run->pool, run->handles[i]);
+        if (run->objects[i] == NULL) return 0;
+        run->objects[i][0] = 0;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Entry point of the striped lock benchmark
+ * @return 0 on success, 1 on failure
+ */
+int main(void){
+    rma_handle_t *handles = malloc(BENCH_OBJECTS * sizeof(*handles));
+    unsigned long **objects = malloc(BENCH_OBJECTS * sizeof(*objects));
+    pthread_mutex_t *mutexes = malloc(BENCH_OBJECTS * sizeof(*mutexes));
+    if (handles == NULL || objects == NULL || mutexes == NULL) return 1;
+
+    printf("%d objects, %d threads x %d updates, best of %d runs\n\n", BENCH_OBJECTS, BENCH_THREADS, BENCH_UPDATES, BENCH_REPEATS);
+    printf("%-22s %14s %14s %12s\n", "lock", "ns/update", "lock bytes", "contended");
+
+    // baseline: the caller keeps one mutex per object
+    struct bench_run_t run = { .handles = handles, .objects = objects, .mutexes = mutexes };
+    if (!benchSetup(0, &run)) return 1;
+    for (size_t i = 0; i < BENCH_OBJECTS; i++) pthread_mutex_init(&mutexes[i], NULL);
+
+    printf("%-22s %14.2f %14zu %12s\n", "pthread mutex/object", benchRun(&run), BENCH_OBJECTS * sizeof(pthread_mutex_t), "-");
+
+    for (size_t i = 0; i < BENCH_OBJECTS; i++) pthread_mutex_destroy(&mutexes[i]);
+    rma_destroy(run.pool);
+    run.mutexes = NULL;
+
+    for (size_t stripes = 16; stripes <= RMA_LOCK_STRIPES_MAX; stripes *= 16){
+        if (!benchSetup(stripes, &run)) return 1;
+
+        double const perUpdate = benchRun(&run);
+        struct rma_stats_t stats;
+        rma_getStats(run.pool, &stats);
+
+        char label[32];
+        snprintf(label, sizeof(label), "rma_lock %zu stripes", stripes);
+        printf("%-22s %14.2f %14zu %12zu\n", label, perUpdate, stripes * 64, stats.lockContended);
+
+        rma_destroy(run.pool);
+    }
+
+    free(mutexes);
+    free(objects);
+    free(handles);
+    return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file memConfig.h
+ * @brief Config-file and environment driven pool construction
+ * @author Robkoo
+ * @date 18.10.2026
+ * @version 0.0.3
+ * @since 0.0.3
+ *
+ * Lets deployments tune pool parameters without recompiling. Parameters
+ * are read from a small `key = value` config file and from `RMA_*`
+ * environment variables, then passed to rma_memHeaderInitEx().
+ */
+
+#ifndef MEM_CONFIG
+#define MEM_CONFIG
+
+#include "memHeader.h"
+
+/**
+ * @brief Pool size used when neither the config file nor the environment sets one
+ */
+#define RMA_DEFAULT_TOTAL_SIZE (1024 * 1024) // 1 MiB
+
+/**
+ * @brief Block size used when neither the config file nor the environment sets one
+ */
+#define RMA_DEFAULT_BLOCK_SIZE (1024) // 1 KiB
+
+/**
+ * @brief Config file read when the RMA_CONFIG environment variable is not set
+ */
+#define RMA_DEFAULT_CONFIG_PATH "rma.conf"
+
+/**
+ * @brief Fully resolved construction parameters of one named pool
+ */
+struct rma_config_t {
+    size_t totalSize;             /**< Total pool size in bytes */
+    size_t blockSize;             /**< Block size in bytes */
+    struct rma_options_t options; /**< Options passed to rma_memHeaderInitEx() */
+};
+
+/**
+ * @brief Resolve the configuration of a named pool
+ * @param name Pool name selecting the `[name]` section and `RMA_<NAME>_*` variables (may be NULL)
+ * @param config Output structure receiving the resolved values (must not be NULL)
+ * @return 1 on success, 0 if a value could not be parsed
+ *
+ * @note Unknown keys are reported on stderr and ignored
+ * @see rma_createFromConfig
+ *
+ * Sources are applied in increasing precedence:
+ * - built-in defaults (RMA_DEFAULT_TOTAL_SIZE, RMA_DEFAULT_BLOCK_SIZE)
+ * - keys before the first section of the config file
+ * - keys in the `[name]` section of the config file
+ * - `RMA_<KEY>` environment variables, e.g. RMA_BLOCK_SIZE
+ * - `RMA_<NAME>_<KEY>` environment variables, e.g. RMA_CACHE_BLOCK_SIZE
+ *
+ * The config file is $RMA_CONFIG, or RMA_DEFAULT_CONFIG_PATH when unset;
+ * a missing file is not an error. Sizes accept K, M and G suffixes (KiB,
+ * MiB, GiB); a size that does not fit size_t is a parse error. Recognized
+ * keys: totalSize, blockSize, alignment,
+ * backing (malloc | mmap), hugePages (0 | 1), epochTags (0 | 1),
+ * metaWidth (0 to RMA_META_MAX_WIDTH), ttl (0 | 1), eviction (0 | 1),
+ * threadSafe (0 | 1), coloring (0 | 1), dedup (0 | 1), sizeTracking (0 | 1),
+ * lockStripes (0 to RMA_LOCK_STRIPES_MAX).
+ */
+int rma_loadConfig(char const *name, struct rma_config_t *config);
+
+/**
+ * @brief Create a pool whose parameters come from the config file and environment
+ * @param name Pool name (may be NULL to use only global settings)
+ * @return Pointer to initialized header structure, or NULL on failure
+ *
+ * @warning Release the pool with rma_destroy()
+ * @see rma_loadConfig, rma_memHeaderInitEx
+ *
+ * Resolves the configuration with rma_loadConfig() and builds the pool
+ * with rma_memHeaderInitEx().
+ */
+struct rma_mem_header_t* rma_createFromConfig(char const *name);
+
+#endif // MEM_CONFIG
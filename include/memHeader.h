@@ -23,6 +23,10 @@
  * Handles are used instead of raw pointers to provide memory safety
  * and allow for memory defragmentation without invalidating references.
  * A handle value of 0 (RMA_INVALID_HANDLE) indicates an invalid handle.
+ *
+ * Block handles hold a 16-bit salt in bits 31..16, the pool tag in bits
+ * 15..12 and a counter below. Handles tagged RMA_INLINE_TAG carry a small
+ * value instead of referring to a block.
  */
 typedef uint32_t rma_handle_t;
 
@@ -34,6 +38,126 @@ typedef uint32_t rma_handle_t;
  */
 #define RMA_INVALID_HANDLE 0
 
+/**
+ * @brief Position of the pool tag inside a handle
+ *
+ * Bits 15..12 of every handle carry the tag of the pool that issued it (0
+ * for top-level pools, nonzero for pools made with rma_createChild()), so
+ * a handle passed to the wrong pool of a family is rejected before any
+ * handle table scan. The handle counter keeps the 12 bits below, so a
+ * freed handle is only told apart from a new one with the same salt for
+ * 4096 allocations (65536 before tags); the salt must collide as well for
+ * a stale handle to resolve.
+ */
+#define RMA_HANDLE_TAG_SHIFT 12
+
+/**
+ * @brief Number of distinct tag values (the last one is RMA_INLINE_TAG)
+ */
+#define RMA_HANDLE_TAGS 16
+
+/**
+ * @brief Pool tag reserved for inline values (see rma_allocValue())
+ *
+ * No pool is ever given this tag. Inline handles keep the value length in
+ * bits 9..8 and up to RMA_INLINE_MAX value bytes: the first two in bits
+ * 31..16, the third in bits 7..0. They use no block and no handle table
+ * entry, and salts keep their full 16 bits.
+ */
+#define RMA_INLINE_TAG (RMA_HANDLE_TAGS - 1)
+
+/**
+ * @brief Largest value in bytes that rma_allocValue() stores in the handle itself
+ */
+#define RMA_INLINE_MAX 3
+
+/**
+ * @brief Bytes at the start of a value block that hold the value length
+ *
+ * A value too long to be inlined is stored as its length (uint32_t)
+ * followed by the bytes, so it can hold up to blockSize - RMA_VALUE_HEADER.
+ */
+#define RMA_VALUE_HEADER sizeof(uint32_t)
+
+/**
+ * @brief Number of levels of the TTL timer wheel
+ */
+#define RMA_TTL_WHEEL_LEVELS 4
+
+/**
+ * @brief Number of slots per timer wheel level (power of two)
+ *
+ * Level n covers delays below RMA_TTL_WHEEL_SLOTS^(n+1) ticks; longer
+ * delays are parked in the top level and re-filed as time advances.
+ */
+#define RMA_TTL_WHEEL_SLOTS 64
+
+/**
+ * @brief Backing store obtained with malloc()/aligned_alloc() (default)
+ */
+#define RMA_BACKING_MALLOC 0
+
+/**
+ * @brief Backing store obtained with an anonymous private mmap()
+ *
+ * Required for huge pages and for returning memory to the OS in place.
+ */
+#define RMA_BACKING_MMAP 1
+
+/**
+ * @brief Pool placed in caller-owned memory by rma_initInPlace()
+ *
+ * The library never frees, remaps or advises such memory.
+ */
+#define RMA_BACKING_EXTERNAL 2
+
+/**
+ * @brief Largest per-block metadata slot in bytes (see rma_options_t::metaWidth)
+ */
+#define RMA_META_MAX_WIDTH 16
+
+/**
+ * @brief Largest striped lock table (see rma_options_t::lockStripes)
+ */
+#define RMA_LOCK_STRIPES_MAX 4096
+
+/**
+ * @brief Padding added to every block of a colored pool (see rma_options_t::coloring)
+ *
+ * One cache line; pools aligned to more than this pad by the alignment instead.
+ */
+#define RMA_COLOR_STEP 64
+
+/**
+ * @brief Address span that maps onto the same L1 cache set once per way
+ *
+ * Blocks whose starts are a multiple of this apart compete for the same
+ * sets. 4 KiB holds for common L1 data caches (32 KiB, 8 ways; 48 KiB, 12 ways).
+ */
+#define RMA_COLOR_PERIOD 4096
+
+/**
+ * @brief Optional pool construction parameters
+ *
+ * A zero-initialized structure (or a NULL pointer) selects the defaults,
+ * which reproduce the behaviour of rma_memHeaderInit(). Options are copied
+ * into the pool header so later operations can recompute the layout.
+ */
+struct rma_options_t {
+    size_t alignment;        /**< Block alignment in bytes (power of two, 0 = none) */
+    int backing;             /**< RMA_BACKING_MALLOC or RMA_BACKING_MMAP */
+    int hugePages;           /**< Nonzero to request huge pages (implies mmap backing) */
+    int epochTags;           /**< Nonzero to tag blocks with an epoch (4 bytes/block) */
+    size_t metaWidth;        /**< Bytes of user metadata per block (0 = none, up to RMA_META_MAX_WIDTH) */
+    int ttl;                 /**< Nonzero to support expiring blocks (16 bytes/block plus the timer wheel) */
+    int eviction;            /**< Nonzero to track block references for rma_allocOrEvict() (1 bit/block) */
+    int threadSafe;          /**< Nonzero to serialize rma_alloc*(), rma_free(), rma_getPtr(), rma_setTTL(), rma_expire() and the epoch calls with a futex lock */
+    int coloring;            /**< Nonzero to pad blocks by RMA_COLOR_STEP so power-of-two sized blocks don't share cache sets */
+    int dedup;               /**< Nonzero to support rma_dedupBlock() (16 bytes/block plus two hash tables of 24 bytes/block) */
+    int sizeTracking;        /**< Nonzero to record the size passed to rma_allocSized() (4 bytes/block) */
+    size_t lockStripes;      /**< Cache-line sized rma_lock() stripes (0 = none, power of two up to RMA_LOCK_STRIPES_MAX) */
+};
+
 /**
  * @brief Main header structure containing all memory pool metadata
  * 
@@ -45,6 +169,7 @@ struct rma_mem_header_t {
     size_t totalSize;        /**< Total pool size in bytes */
     size_t usedSize;         /**< Currently used bytes (including metadata) */
     size_t blockSize;        /**< Size of each individual block in bytes */
+    size_t blockStride;      /**< Distance between block starts (blockSize, plus RMA_COLOR_STEP when colored) */
     
     size_t numBlocks;        /**< Number of allocatable blocks in pool */
     size_t numAllocated;     /**< Currently allocated blocks count */
@@ -52,10 +177,116 @@ struct rma_mem_header_t {
     uint32_t nextHandle;     /**< Next handle ID to assign (starts at 1) */
 
     size_t bitmapOffset;     /**< Byte offset from pool start to bitmap */
+    size_t pinnedBitmapOffset; /**< Byte offset from pool start to the pinned-block bitmap */
     size_t handleTableOffset; /**< Byte offset from pool start to handle table */
     size_t dataOffset;       /**< Byte offset from pool start to first block */
+    size_t epochTableOffset; /**< Byte offset to the epoch tag array (0 = disabled) */
+    size_t sizeTableOffset;  /**< Byte offset to the requested-size array (0 = disabled) */
+    size_t metaTableOffset;  /**< Byte offset to the user metadata array (0 = disabled) */
+    size_t ttlTableOffset;   /**< Byte offset to the per-block expiry entries (0 = disabled) */
+    size_t timerWheelOffset; /**< Byte offset to the TTL timer wheel (0 = disabled) */
+    size_t refBitmapOffset;  /**< Byte offset to the referenced-block bitmap (0 = disabled) */
+    size_t lockTableOffset;  /**< Byte offset to the rma_lock() stripes (0 = disabled) */
+    size_t dedupBlocksOffset; /**< Byte offset to the per-block dedup state (0 = disabled) */
+    size_t dedupIndexOffset; /**< Byte offset to the content hash index */
+    size_t dedupAliasOffset; /**< Byte offset to the table of merged handles */
+    size_t dedupCapacity;    /**< Slots in each dedup hash table (power of two) */
+    size_t numIndexed;       /**< Blocks present in the content index */
+    size_t numAliases;       /**< Handles sharing another handle's block */
+
+    int registered;          /**< Nonzero while the pool is listed by rma_registerPool() */
+    struct rma_stats_page_t *statsPage; /**< Shared-memory page kept up to date by rma_publishStats() (NULL = none) */
+
+    uint32_t poolTag;        /**< Tag stored in bits 15..12 of every handle this pool issues */
+    uint32_t childTags;      /**< Bit mask of the tags held by live children */
+    size_t numChildren;      /**< Live pools carved from this one with rma_createChild() */
+    struct rma_mem_header_t *parent; /**< Pool this child was carved from (NULL = top-level pool) */
+    rma_handle_t parentHandle; /**< Handle the child's block run is held under in the parent (carries the child's tag) */
+    size_t parentFirstBlock; /**< First parent block of the child's run */
+    size_t parentBlocks;     /**< Length of the child's run in parent blocks */
+
+    size_t clockHand;        /**< Next block examined by the CLOCK eviction sweep */
+
+    uint32_t lockWord;       /**< Futex pool lock (0 free, 1 locked, 2 contended), used with options.threadSafe */
+    uint32_t freeSequence;   /**< Futex word bumped when a block is freed while threads wait */
+    uint32_t waiters;        /**< Threads blocked in rma_allocWait() */
+    int eventFd;             /**< eventfd signalled when a full pool frees a block (-1 = none) */
+
+    uint64_t currentTick;    /**< Time of the last rma_expire() call, TTLs count from here */
+    size_t numTimers;        /**< Number of blocks with a pending expiry */
+
+    uint32_t currentEpoch;   /**< Epoch new allocations are tagged with (0 = none) */
+    uint32_t nextEpoch;      /**< Next epoch ID handed out by rma_beginEpoch() */
+
+    struct rma_options_t options; /**< Options the pool was created with */
+    int backing;             /**< RMA_BACKING_* actually used for the pool memory */
+    size_t mappedSize;       /**< Bytes reserved from the backing store (>= totalSize) */
+    size_t mapGranularity;   /**< Page size of the backing mapping in bytes (1 for malloc) */
 };
 
+/**
+ * @brief Computed placement of every section inside an RMA memory pool
+ *
+ * Produced by rma_computeLayout() and consumed by rma_memHeaderInit().
+ * Exposing it lets offline tools (see tools/rmaTune.c) reason about the
+ * exact same layout math the library uses instead of re-deriving it.
+ */
+struct rma_layout_t {
+    size_t numBlocks;         /**< Number of allocatable blocks that fit */
+    size_t blockStride;       /**< Distance between block starts in bytes */
+    size_t bitmapOffset;      /**< Byte offset from pool start to bitmap */
+    size_t pinnedBitmapOffset; /**< Byte offset from pool start to the pinned-block bitmap */
+    size_t handleTableOffset; /**< Byte offset from pool start to handle table */
+    size_t dataOffset;        /**< Byte offset from pool start to first block */
+    size_t epochTableOffset;  /**< Byte offset to the epoch tag array (0 = disabled) */
+    size_t sizeTableOffset;   /**< Byte offset to the requested-size array (0 = disabled) */
+    size_t metaTableOffset;   /**< Byte offset to the user metadata array (0 = disabled) */
+    size_t ttlTableOffset;    /**< Byte offset to the per-block expiry entries (0 = disabled) */
+    size_t timerWheelOffset;  /**< Byte offset to the TTL timer wheel (0 = disabled) */
+    size_t refBitmapOffset;   /**< Byte offset to the referenced-block bitmap (0 = disabled) */
+    size_t lockTableOffset;   /**< Byte offset to the rma_lock() stripes (0 = disabled) */
+    size_t dedupBlocksOffset; /**< Byte offset to the per-block dedup state (0 = disabled) */
+    size_t dedupIndexOffset;  /**< Byte offset to the content hash index */
+    size_t dedupAliasOffset;  /**< Byte offset to the table of merged handles */
+    size_t dedupCapacity;     /**< Slots in each dedup hash table (power of two) */
+};
+
+/**
+ * @brief Compute the section layout of a pool without allocating it
+ * @param totalSize Total size in bytes for the memory pool
+ * @param blockSize Size in bytes for each individual block (must be > 0)
+ * @param options Pool options, or NULL for defaults
+ * @param layout Output structure receiving the computed offsets (must not be NULL)
+ * @return 1 on success, 0 if the parameters cannot hold a single block
+ *
+ * @note With a non-zero options->alignment, blockSize must be a multiple
+ *       of the alignment and the data section is aligned to it
+ * @note options->metaWidth above RMA_META_MAX_WIDTH is rejected
+ *
+ * @see rma_memHeaderInit, rma_poolSizeForBlocks
+ *
+ * The metadata arrays are sized for the theoretical block count
+ * (totalSize minus header, divided by blockSize), then the real block
+ * count is whatever fits behind them. This is the single source of truth
+ * for pool layout; rma_memHeaderInit() calls it internally.
+ */
+int rma_computeLayout(size_t totalSize, size_t blockSize, struct rma_options_t const *options, struct rma_layout_t *layout);
+
+/**
+ * @brief Find the smallest pool size that provides at least numBlocks blocks
+ * @param numBlocks Required number of allocatable blocks (must be > 0)
+ * @param blockSize Size in bytes for each individual block (must be > 0)
+ * @param options Pool options, or NULL for defaults
+ * @return Minimal totalSize in bytes, or 0 on overflow or invalid options
+ *
+ * @see rma_computeLayout
+ *
+ * Inverts rma_computeLayout() by starting from the metadata-free estimate
+ * and growing one block at a time until the layout fits numBlocks blocks.
+ * Converges in a handful of iterations since metadata is ~4 bytes/block.
+ */
+size_t rma_poolSizeForBlocks(size_t numBlocks, size_t blockSize, struct rma_options_t const *options);
+
 /**
  * @brief Initialize a new RMA memory pool with specified parameters
  * @param totalSize Total size in bytes for the memory pool (must be > 1KB)
@@ -64,8 +295,8 @@ struct rma_mem_header_t {
  * 
  * @note The actual number of blocks may be less than totalSize/blockSize
  *       due to metadata overhead (bitmap, handle table, header)
- * @warning Caller is responsible for calling free() on the returned pointer
- * @see rma_displayMemInfo, rma_alloc, rma_free
+ * @warning Caller is responsible for calling rma_destroy() (or free()) on the returned pointer
+ * @see rma_memHeaderInitEx, rma_destroy, rma_displayMemInfo, rma_alloc, rma_free
  * 
  * Creates a single large memory allocation and subdivides it into:
  * - Header structure (metadata)
@@ -75,6 +306,89 @@ struct rma_mem_header_t {
  */
 void* rma_memHeaderInit(size_t totalSize, size_t blockSize);
 
+/**
+ * @brief Initialize a new RMA memory pool with explicit options
+ * @param totalSize Total size in bytes for the memory pool (must be > 1KB)
+ * @param blockSize Size in bytes for each individual block (must be > 0)
+ * @param options Pool options, or NULL for defaults
+ * @return Pointer to initialized header structure, or NULL on failure
+ *
+ * @warning Pools created with mmap backing must be released with rma_destroy()
+ * @see rma_memHeaderInit, rma_destroy, rma_createFromConfig
+ *
+ * Same as rma_memHeaderInit() but allows choosing block alignment and the
+ * backing store. With hugePages set the pool is first mapped with
+ * MAP_HUGETLB; if no huge pages are reserved it falls back to a regular
+ * mapping advised with MADV_HUGEPAGE (transparent huge pages).
+ */
+void* rma_memHeaderInitEx(size_t totalSize, size_t blockSize, struct rma_options_t const *options);
+
+/**
+ * @brief Build a pool inside memory owned by the caller
+ * @param mem Start of the buffer (aligned to max_align_t and to options->alignment)
+ * @param size Size of the buffer in bytes, becomes the pool's totalSize
+ * @param blockSize Size in bytes for each individual block (must be > 0)
+ * @param options Pool options, or NULL for defaults (backing and hugePages are ignored)
+ * @return Pointer to the header at the start of mem, or NULL if the buffer is misaligned or too small
+ *
+ * @warning The buffer must outlive the pool; rma_destroy() leaves it untouched
+ * @see rma_memHeaderInitEx, rma_poolSizeForBlocks
+ *
+ * Performs no allocation: header, bitmap, handle table and blocks are all
+ * laid out inside mem, so a pool can live in a static or stack buffer, a
+ * hugepage segment or a region of another allocator. rma_resize() only
+ * succeeds while the new size fits in the original buffer; rma_clone()
+ * copies into a regular malloc()/mmap() pool.
+ */
+void* rma_initInPlace(void *mem, size_t size, size_t blockSize, struct rma_options_t const *options);
+
+/**
+ * @brief Release a pool and its backing store
+ * @param header Pointer to the pool header (NULL is ignored)
+ *
+ * @warning All handles and pointers into the pool become invalid
+ * @see rma_memHeaderInit, rma_memHeaderInitEx
+ *
+ * Returns the memory with free() or munmap() depending on how the pool
+ * was backed, unless the warm pool cache, which is off by default, takes
+ * it (see rma_setPoolCacheLimit()). Memory passed to rma_initInPlace() is left to
+ * its owner; a child pool's block run goes back to its parent.
+ *
+ * A pool with live children (see rma_createChild()) is left untouched,
+ * since their memory is part of it; destroy the children first.
+ */
+void rma_destroy(struct rma_mem_header_t *header);
+
+/**
+ * @brief Carve a child pool out of a run of contiguous parent blocks
+ * @param parent Pool providing the memory (must not be NULL)
+ * @param size Minimum size of the child pool in bytes
+ * @param blockSize Block size of the child pool (must be > 0)
+ * @return Header of the child pool, or NULL if the parent has no free run
+ *         long enough or the child layout doesn't fit
+ *
+ * @warning Destroy every child before its parent; a parent with live
+ *          children refuses rma_destroy(), rma_resize() and rma_clone()
+ * @see rma_initInPlace, rma_destroy
+ *
+ * The run is claimed first-fit under a single parent handle and pinned, so
+ * rma_compact(), eviction and rma_freeEpoch() leave it alone, and the child
+ * is built in it with rma_initInPlace() (inheriting the parent's alignment
+ * and threadSafe options), starting at the run's first address aligned to
+ * max_align_t. rma_destroy() on the child hands the whole run
+ * back to the parent in one step.
+ *
+ * Each child gets the lowest tag below RMA_INLINE_TAG that none of its
+ * ancestors and no live sibling holds, so handles passed to the wrong pool
+ * of a family fail with -3 without scanning. A parent therefore has at
+ * most 14 live children (fewer further down the tree); once every tag is
+ * taken, this fails. The parent handle of the run
+ * (parentHandle) carries the child's tag too: rma_free(), rma_setTTL(),
+ * rma_unpin() and the other parent calls reject it with -3 or NULL, and
+ * only rma_destroy() on the child releases the run.
+ */
+struct rma_mem_header_t* rma_createChild(struct rma_mem_header_t *parent, size_t size, size_t blockSize);
+
 /**
  * @brief Allocate a memory block and return its handle
  * @param header Pointer to initialized RMA header (must not be NULL)
@@ -96,6 +410,83 @@ void* rma_memHeaderInit(size_t totalSize, size_t blockSize);
  */
 rma_handle_t rma_alloc(struct rma_mem_header_t *header);
 
+/**
+ * @brief Allocate a block for an object of a known size
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param size Bytes the caller will use (1 to blockSize)
+ * @return Handle to allocated block, or RMA_INVALID_HANDLE on failure or if size doesn't fit a block
+ *
+ * @see rma_getSize, rma_getStats
+ *
+ * Behaves like rma_alloc(); with options.sizeTracking the size is also
+ * stored in a 4-byte side array, so rma_getStats() can report how much of
+ * every block is wasted and which request sizes occur. Blocks from
+ * rma_alloc() have no recorded size and are left out of those figures.
+ */
+rma_handle_t rma_allocSized(struct rma_mem_header_t *header, size_t size);
+
+/**
+ * @brief Get the size recorded by rma_allocSized()
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param handle Handle of an allocated block
+ * @return Recorded size in bytes, or 0 if the handle is invalid, the pool
+ *         has no options.sizeTracking or the block came from rma_alloc()
+ */
+size_t rma_getSize(struct rma_mem_header_t *header, rma_handle_t handle);
+
+/**
+ * @brief Store a small value, inside the handle when it fits
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param value Bytes to store (may be NULL when length is 0)
+ * @param length Value length in bytes (up to blockSize - RMA_VALUE_HEADER)
+ * @return Inline handle for values of up to RMA_INLINE_MAX bytes, a block
+ *         handle for longer ones, or RMA_INVALID_HANDLE on failure
+ *
+ * @see rma_getValue, rma_setValue, rma_isInline, RMA_VALUE_HEADER
+ *
+ * Counters, small ids and flags take no block and no handle table entry.
+ * Longer values get a block that starts with their length, like
+ * rma_allocSized() of RMA_VALUE_HEADER + length bytes.
+ */
+rma_handle_t rma_allocValue(struct rma_mem_header_t *header, void const *value, size_t length);
+
+/**
+ * @brief Read a value stored with rma_allocValue() or rma_setValue()
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param handle Inline or block handle
+ * @param out Buffer receiving up to capacity bytes (may be NULL when capacity is 0)
+ * @param capacity Size of out in bytes
+ * @return Length of the value, or 0 for an invalid handle
+ *
+ * Only reads block handles returned by rma_allocValue() or rma_setValue();
+ * a block from rma_alloc() has no value length.
+ */
+size_t rma_getValue(struct rma_mem_header_t *header, rma_handle_t handle, void *out, size_t capacity);
+
+/**
+ * @brief Replace the value behind a handle
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param handle Inline or block handle (RMA_INVALID_HANDLE behaves like rma_allocValue())
+ * @param value New bytes (may be NULL when length is 0)
+ * @param length New length in bytes (up to blockSize - RMA_VALUE_HEADER)
+ * @return Handle now holding the value (store it in place of the old one),
+ *         or RMA_INVALID_HANDLE on failure (the old handle stays valid)
+ *
+ * An inline value is re-encoded, or moved into a freshly allocated block
+ * once it grows beyond RMA_INLINE_MAX bytes. A block keeps its handle and
+ * is overwritten in place, even when the value shrinks again. The write
+ * goes through rma_getPtrMut(), so a block shared through rma_dedupBlock()
+ * is copied first and fails like it when the pool is full.
+ */
+rma_handle_t rma_setValue(struct rma_mem_header_t *header, rma_handle_t handle, void const *value, size_t length);
+
+/**
+ * @brief Tell whether a handle carries its value inline
+ * @param handle Any handle
+ * @return 1 for inline handles, 0 for block handles and RMA_INVALID_HANDLE
+ */
+int rma_isInline(rma_handle_t handle);
+
 /**
  * @brief Free a previously allocated memory block by handle
  * @param header Pointer to initialized RMA header (must not be NULL)
@@ -115,9 +506,43 @@ rma_handle_t rma_alloc(struct rma_mem_header_t *header);
  * - 0: Invalid handle (RMA_INVALID_HANDLE or NULL header)
  * - -1: Handle not found in handle table
  * - -2: Block not actually allocated
+ * - -3: Handle was issued by another pool (pool tag mismatch)
+ *
+ * Inline handles own no block; freeing one does nothing and returns 1.
  */
 int rma_free(struct rma_mem_header_t *header, rma_handle_t handle);
 
+/**
+ * @brief Allocate a block, sleeping until one is freed if the pool is full
+ * @param header Pointer to initialized RMA header created with options.threadSafe (must not be NULL)
+ * @param timeoutMs Maximum time to wait in milliseconds, -1 to wait forever, 0 to not wait
+ * @return Handle to the allocated block, or RMA_INVALID_HANDLE on timeout or failure
+ *
+ * @see rma_free, rma_eventFd
+ *
+ * Replaces spinning on rma_alloc(): the caller registers as a waiter and
+ * sleeps on a futex that rma_free() (and every other path releasing a
+ * block) wakes. The free path only checks the waiter count, so it pays
+ * nothing extra while nobody waits. Pools without threadSafe never wait,
+ * since no other thread may free concurrently.
+ */
+rma_handle_t rma_allocWait(struct rma_mem_header_t *header, int timeoutMs);
+
+/**
+ * @brief Get an eventfd that becomes readable when a full pool frees a block
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @return Non-blocking eventfd, or -1 on failure
+ *
+ * @note The fd is owned by the pool and closed by rma_destroy()
+ * @see rma_allocWait
+ *
+ * Lets epoll based event loops park producers instead of blocking a
+ * thread. Created on first use; the counter is incremented each time a
+ * release takes the pool out of the exhausted state, so after reading it
+ * (which resets it) retry rma_alloc() until it fails again.
+ */
+int rma_eventFd(struct rma_mem_header_t *header);
+
 /**
  * @brief Convert a handle to a usable memory pointer
  * @param header Pointer to initialized RMA header (must not be NULL)
@@ -131,15 +556,691 @@ int rma_free(struct rma_mem_header_t *header, rma_handle_t handle);
  * Validates the handle, locates the corresponding block index, and
  * calculates the actual memory address within the data section.
  * The returned pointer can be used for reading/writing up to blockSize bytes.
- * 
+ * In pools with options.eviction it also marks the block as recently used.
+ * A block shared through rma_dedupBlock() must be written via rma_getPtrMut().
+ *
  * Returns NULL if:
  * - header is NULL
+ * - handle is inline (read it with rma_getValue(), see rma_allocValue())
  * - handle is invalid or freed
  * - handle not found in handle table
  * - block is not marked as allocated
  */
 void* rma_getPtr(struct rma_mem_header_t *header, rma_handle_t handle);
 
+/**
+ * @brief Convert a handle to a pointer the caller is going to write through
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param handle Handle to convert to pointer (must be valid)
+ * @return Pointer to a block only this handle references, or NULL on failure
+ *
+ * @see rma_dedupBlock
+ *
+ * Copy-on-write for deduplicated blocks: when other handles share the
+ * block, its contents (and user metadata) are copied into a free block
+ * that the handle moves to, so the other handles keep seeing the old
+ * contents. An exclusive block is returned directly, after dropping it
+ * from the content index since its contents are about to change.
+ *
+ * Returns NULL if the handle is invalid or inline (use rma_setValue()), or
+ * a shared block has to be copied while the pool is full.
+ */
+void* rma_getPtrMut(struct rma_mem_header_t *header, rma_handle_t handle);
+
+/**
+ * @brief Merge a block into an existing block with identical contents
+ * @param header Pointer to a pool created with options.dedup (must not be NULL)
+ * @param handle Handle of the block to deduplicate
+ * @return 1 if merged (or already shared), 0 if no duplicate was found, negative on error
+ *
+ * @see rma_getPtrMut, rma_options_t::dedup
+ *
+ * Hashes the block's contents and looks the hash up in the pool's content
+ * index. On a byte-exact match the handle becomes an alias of the matching
+ * block (which gains a reference) and its own block is freed. Otherwise
+ * the block is added to the index so later duplicates can merge into it.
+ *
+ * Aliases resolve through every handle based call. Freeing any handle of a
+ * shared block only drops that reference; the block is released with its
+ * last handle. Writing through rma_getPtr() into a shared block changes it
+ * for every handle, use rma_getPtrMut() instead. Per-block user metadata,
+ * TTL and epoch belong to the shared block, and releasing the block by
+ * other means (expiry, eviction, epoch sweep) invalidates all its handles.
+ *
+ * Return values:
+ * - 1: Handle now shares a block with other handles
+ * - 0: No identical block, the block was indexed (or the alias table is full)
+ * - -1: Invalid handle or pool created without options.dedup
+ * - -2: Block is pinned and cannot be freed
+ */
+int rma_dedupBlock(struct rma_mem_header_t *header, rma_handle_t handle);
+
+/**
+ * @brief Start a new allocation epoch
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @return New epoch ID, or 0 if the pool was created without epochTags
+ *
+ * @note Only one epoch is current at a time; beginning a new one replaces it
+ * @see rma_endEpoch, rma_freeEpoch
+ *
+ * Every block allocated while the epoch is current is tagged with its ID,
+ * so all of them can later be released together by rma_freeEpoch().
+ * Blocks allocated outside an epoch carry tag 0 and are never swept.
+ */
+uint32_t rma_beginEpoch(struct rma_mem_header_t *header);
+
+/**
+ * @brief Stop tagging new allocations with the current epoch
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ *
+ * @see rma_beginEpoch, rma_freeEpoch
+ *
+ * Allocations made afterwards are long-lived (tag 0) again. Blocks already
+ * tagged keep their epoch and can still be freed with rma_freeEpoch().
+ */
+void rma_endEpoch(struct rma_mem_header_t *header);
+
+/**
+ * @brief Free every block allocated during an epoch
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param epoch Epoch ID returned by rma_beginEpoch() (must not be 0)
+ * @return Number of blocks freed
+ *
+ * @warning All handles allocated in the epoch become invalid
+ * @see rma_beginEpoch, rma_endEpoch, rma_free
+ *
+ * Sweeps the tag array 32 blocks at a time: the tag comparison builds a
+ * branch-free match mask per bitmap word (vectorizable by the compiler),
+ * which is then intersected with the bitmap so only the matching allocated
+ * blocks are released. Replaces one rma_free() call - and its O(n) handle
+ * lookup - per block. If the epoch is still current it is ended.
+ */
+size_t rma_freeEpoch(struct rma_mem_header_t *header, uint32_t epoch);
+
+/**
+ * @brief Get the user metadata slot of a block
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param handle Handle of an allocated block
+ * @return Pointer to the block's options.metaWidth metadata bytes, or NULL if
+ *         the handle is invalid or the pool has no metadata
+ *
+ * @see rma_metaTable
+ *
+ * Metadata lives in a side array next to the handle table instead of the
+ * block itself, so it does not cost the block's alignment and scanning it
+ * does not touch data cache lines. Slots are zeroed when a block is freed
+ * and move with the block during compaction.
+ */
+void* rma_meta(struct rma_mem_header_t *header, rma_handle_t handle);
+
+/**
+ * @brief Get the whole user metadata array for linear scans
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @return Pointer to numBlocks packed slots of options.metaWidth bytes, or
+ *         NULL if the pool has no metadata
+ *
+ * @see rma_meta, rma_handleAt
+ *
+ * Slot i belongs to block index i; free blocks read as zero. The array is
+ * padded to a multiple of 32 slots, so vectorized scans may process whole
+ * chunks without a scalar tail. Use rma_handleAt() to turn a matching
+ * index back into a handle.
+ */
+void* rma_metaTable(struct rma_mem_header_t *header);
+
+/**
+ * @brief Get the handle of the block at a given index
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param blockIndex Block index (e.g. a slot found by scanning rma_metaTable())
+ * @return Handle of the block, or RMA_INVALID_HANDLE if it is free or out of range
+ */
+rma_handle_t rma_handleAt(struct rma_mem_header_t *header, size_t blockIndex);
+
+/**
+ * @brief Callback invoked for a block the library is about to release
+ * @param header Pool the block belongs to
+ * @param handle Handle of the block, still valid during the call
+ * @param context User pointer passed through from the caller
+ *
+ * The block's data and metadata can be read during the call. The callback
+ * may free the block itself, it is then not released a second time. In
+ * threadSafe pools it runs with the pool locked; calls back into the same
+ * pool from the callback's thread do not lock again.
+ */
+typedef void (*rma_block_callback_t)(struct rma_mem_header_t *header, rma_handle_t handle, void *context);
+
+/**
+ * @brief Allocate a block that expires after a number of ticks
+ * @param header Pointer to initialized RMA header created with options.ttl (must not be NULL)
+ * @param ttl Lifetime in ticks, counted from header->currentTick (0 is treated as 1)
+ * @return Handle to the allocated block, or RMA_INVALID_HANDLE on failure
+ *
+ * @see rma_expire, rma_setTTL
+ *
+ * Ticks are whatever unit the caller passes to rma_expire() (seconds,
+ * milliseconds, request counts). The block stays valid until it is freed
+ * or an rma_expire() call reaches its expiry tick.
+ */
+rma_handle_t rma_allocWithTTL(struct rma_mem_header_t *header, uint64_t ttl);
+
+/**
+ * @brief Change or cancel the expiry of an allocated block
+ * @param header Pointer to initialized RMA header created with options.ttl (must not be NULL)
+ * @param handle Handle of an allocated block
+ * @param ttl New lifetime in ticks from header->currentTick, or 0 to never expire
+ * @return 1 on success, 0 if the handle is invalid or the pool has no TTL support
+ *
+ * Lets a cache extend an entry on access; O(1) apart from the handle lookup.
+ */
+int rma_setTTL(struct rma_mem_header_t *header, rma_handle_t handle, uint64_t ttl);
+
+/**
+ * @brief Advance the pool clock and free every block that has expired
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param now Current time in ticks; calls with a time in the past do nothing
+ * @param onExpire Optional callback run for each block before it is freed (may be NULL)
+ * @param context User pointer passed to onExpire
+ * @return Number of blocks released by this call; blocks the callback frees
+ *         itself or re-arms or cancels with rma_setTTL() are not counted
+ *
+ * @warning Handles of expired blocks become invalid
+ * @see rma_allocWithTTL
+ *
+ * Expiring blocks sit in a hierarchical timer wheel (RMA_TTL_WHEEL_LEVELS
+ * levels of RMA_TTL_WHEEL_SLOTS slots) stored in the pool. Each tick frees
+ * the blocks of one slot; at level boundaries the slot of the next level
+ * is cascaded down. Every block is touched a bounded number of times, so
+ * the cost is amortized O(1) per expiry without scanning the pool, and
+ * the clock jumps straight to the next occupied slot of any level using
+ * per-level occupancy masks, so idle stretches cost nothing per tick.
+ */
+size_t rma_expire(struct rma_mem_header_t *header, uint64_t now, rma_block_callback_t onExpire, void *context);
+
+/**
+ * @brief Allocate a block, evicting a cold one when the pool is full
+ * @param header Pointer to initialized RMA header created with options.eviction (must not be NULL)
+ * @param onEvict Optional callback run for the victim before it is freed (may be NULL)
+ * @param context User pointer passed to onEvict
+ * @return Handle to the allocated block, or RMA_INVALID_HANDLE if every block is pinned
+ *
+ * @warning The victim's handle becomes invalid
+ * @see rma_getPtr, rma_pin
+ *
+ * Implements CLOCK (second chance): rma_getPtr() sets a reference bit per
+ * block, and when no block is free a hand sweeps the bitmap from where it
+ * last stopped, clearing reference bits until it finds an allocated,
+ * unpinned, unreferenced block. The sweep handles 32 blocks per bitmap
+ * word, so the cost is amortized O(1) per eviction. Pinned blocks are
+ * never evicted.
+ */
+rma_handle_t rma_allocOrEvict(struct rma_mem_header_t *header, rma_block_callback_t onEvict, void *context);
+
+/**
+ * @brief Allocated bytes above which rma_clone() copies with several threads
+ */
+#define RMA_CLONE_PARALLEL_THRESHOLD (8u * 1024 * 1024) // 8 MiB
+
+/**
+ * @brief Upper bound on the number of threads rma_clone() copies with
+ */
+#define RMA_CLONE_MAX_THREADS 8
+
+/**
+ * @brief Duplicate a pool, copying only metadata and allocated blocks
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @return Pointer to the new pool's header, or NULL on failure or if the
+ *         pool has live children (see rma_createChild())
+ *
+ * @note Handles of the source pool are valid in the clone and refer to copies of the same data
+ * @warning Contents of free blocks in the clone are undefined
+ * @see rma_destroy
+ *
+ * Allocates a pool with the same size and options, copies the header and
+ * all metadata (bitmap, handle table, side arrays) verbatim, then copies
+ * only the contiguous runs of allocated blocks found by scanning the
+ * bitmap a word at a time; free ranges are skipped. When more than
+ * RMA_CLONE_PARALLEL_THRESHOLD bytes are allocated the runs are split
+ * across up to RMA_CLONE_MAX_THREADS threads by byte volume.
+ */
+struct rma_mem_header_t* rma_clone(struct rma_mem_header_t *header);
+
+/**
+ * @brief Grow or shrink a pool in place, keeping every handle valid
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param newTotalSize New total pool size in bytes
+ * @return New header pointer (may differ from header), or NULL on failure
+ *
+ * @note On failure the original pool is left untouched and remains valid
+ * @warning Raw pointers from rma_getPtr() are invalidated, re-resolve the handles
+ * @see rma_computeLayout, rma_memHeaderInitEx
+ *
+ * The bitmap, handle table and side arrays are sized from the block count,
+ * so their offsets change with the pool size. The sections are relocated
+ * to the offsets rma_computeLayout() gives for newTotalSize; handles are
+ * resolved through the handle table and survive the move, even when the
+ * base address changes.
+ *
+ * mmap-backed pools are resized with mremap() (growing may move the
+ * mapping, shrinking happens in place and returns the tail pages to the
+ * OS). malloc-backed pools fall back to realloc().
+ *
+ * Shrinking fails if any block beyond the new block count is allocated.
+ * Pools with live children (see rma_createChild()) can't be resized,
+ * since moving them would pull the children's memory away.
+ */
+struct rma_mem_header_t* rma_resize(struct rma_mem_header_t *header, size_t newTotalSize);
+
+/**
+ * @brief Pin a block so compaction never moves it
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param handle Handle of the block to pin (must be valid)
+ * @return 1 on success, otherwise the rma_free() error codes (0, -1, -2)
+ *
+ * @see rma_unpin, rma_compact
+ *
+ * Use for blocks whose raw pointer is held across a compaction (e.g.
+ * handed to I/O). Freeing a pinned block clears the pin.
+ */
+int rma_pin(struct rma_mem_header_t *header, rma_handle_t handle);
+
+/**
+ * @brief Allow compaction to move a previously pinned block again
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param handle Handle of the block to unpin (must be valid)
+ * @return 1 on success, otherwise the rma_free() error codes (0, -1, -2)
+ *
+ * @see rma_pin, rma_compact
+ */
+int rma_unpin(struct rma_mem_header_t *header, rma_handle_t handle);
+
+/**
+ * @brief Lock the contents of a block against other rma_lock() callers
+ * @param header Pointer to RMA header created with options.lockStripes (must not be NULL)
+ * @param handle Handle of the block
+ * @return 1 once the lock is held, 0 if the pool has no lock stripes or the handle is RMA_INVALID_HANDLE
+ *
+ * @warning Handles sharing a stripe exclude each other, so don't hold two
+ *          locks of one pool at once (or take them in a fixed order)
+ * @see rma_unlock, rma_getStats
+ *
+ * Replaces a caller-side mutex per object with a fixed table of
+ * options.lockStripes futex locks, each on its own cache line. The stripe
+ * is picked by hashing the handle, which stays the same while compaction
+ * or rma_resize() moves the block, and the handle is not validated, so
+ * locking costs no handle table scan. Uncontended lock and unlock are one
+ * atomic each; acquisitions and contended acquisitions are counted per
+ * stripe and summed by rma_getStats().
+ */
+int rma_lock(struct rma_mem_header_t *header, rma_handle_t handle);
+
+/**
+ * @brief Release a lock taken with rma_lock()
+ * @param header Pointer to RMA header (must not be NULL)
+ * @param handle Handle passed to rma_lock()
+ * @return 1 on success, 0 if the pool has no lock stripes or the handle is RMA_INVALID_HANDLE
+ */
+int rma_unlock(struct rma_mem_header_t *header, rma_handle_t handle);
+
+/**
+ * @brief Move allocated blocks towards the start of the data section
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @return Number of blocks moved
+ *
+ * @warning Raw pointers to unpinned blocks are invalidated, re-resolve the handles
+ * @see rma_pin, rma_shrinkToFit
+ *
+ * Two-finger compaction: the highest allocated, unpinned block is moved
+ * into the lowest free slot until the two meet. Handles stay valid since
+ * the salt moves with the data. Pinned blocks stay where they are.
+ */
+size_t rma_compact(struct rma_mem_header_t *header);
+
+/**
+ * @brief Compact the pool and give the unused tail back
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param slackPercent Free blocks to keep, as a percentage of the allocated count
+ * @return Number of bytes returned to the operating system
+ *
+ * @note The header never moves, so existing pool pointers stay valid
+ * @warning Raw pointers to unpinned blocks are invalidated (see rma_compact())
+ * @see rma_compact, rma_resize
+ *
+ * Runs rma_compact(), then truncates the data section to the allocated
+ * blocks plus slack (but never below the last pinned block). The data
+ * section keeps its offset, so no block moves during the truncation; the
+ * metadata arrays keep their old size (~4 bytes per removed block). For
+ * mmap-backed pools the tail is unmapped in place and whole pages of the
+ * remaining free blocks are released with MADV_DONTNEED. malloc-backed
+ * pools shrink logically but cannot return memory, so 0 is reported.
+ */
+size_t rma_shrinkToFit(struct rma_mem_header_t *header, unsigned slackPercent);
+
+/**
+ * @brief Prefetch for reading (rw argument of the prefetch functions)
+ */
+#define RMA_PREFETCH_READ 0
+
+/**
+ * @brief Prefetch for writing (rw argument of the prefetch functions)
+ */
+#define RMA_PREFETCH_WRITE 1
+
+/**
+ * @brief Maximum number of cache lines prefetched per block
+ *
+ * Larger blocks only get their first lines prefetched; the hardware
+ * prefetcher picks up sequential access from there.
+ */
+#define RMA_PREFETCH_MAX_LINES 4
+
+/**
+ * @brief Resolve a handle and prefetch the start of its block
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param handle Handle whose block will be accessed soon
+ * @param rw RMA_PREFETCH_READ or RMA_PREFETCH_WRITE
+ * @param locality Temporal locality hint 0 (none) to 3 (keep in all cache levels)
+ * @return 1 if the handle was found and prefetched, 0 otherwise
+ *
+ * @see rma_prefetchBatch, rma_getPtrPrefetchNext
+ *
+ * Handle resolution in RMA is a scan of the handle table, which brings the
+ * table entry into cache by itself; the dependent load that stalls is the
+ * block data. This issues prefetches for the first RMA_PREFETCH_MAX_LINES
+ * cache lines of the block so the later access hits.
+ */
+int rma_prefetch(struct rma_mem_header_t *header, rma_handle_t handle, int rw, int locality);
+
+/**
+ * @brief Resolve many handles in one pass and prefetch their blocks
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param handles Array of handles to resolve (must not be NULL)
+ * @param count Number of handles
+ * @param ptrs Optional output array receiving each block pointer (NULL if not found)
+ * @param rw RMA_PREFETCH_READ or RMA_PREFETCH_WRITE
+ * @param locality Temporal locality hint 0 to 3
+ * @return Number of handles that resolved to a block (duplicates count each time)
+ *
+ * @see rma_prefetch
+ *
+ * Sorts the salts of the batch and walks the handle table once, instead of
+ * one full scan per handle, then prefetches every found block. With ptrs
+ * the resolved pointers can be used directly, skipping rma_getPtr().
+ */
+size_t rma_prefetchBatch(struct rma_mem_header_t *header, rma_handle_t const *handles, size_t count, void **ptrs, int rw, int locality);
+
+/**
+ * @brief Get a block pointer while prefetching the block needed next
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param handle Handle to convert to a pointer
+ * @param nextHandle Handle the caller will dereference next (may be RMA_INVALID_HANDLE)
+ * @return Pointer to handle's block, or NULL on failure (see rma_getPtr())
+ *
+ * @see rma_getPtr, rma_prefetch
+ *
+ * For pipelined traversals (lists, trees of handles): nextHandle's block
+ * is prefetched for reading, so its miss overlaps with work on the
+ * current block. The calling thread remembers where nextHandle resolved,
+ * so when the next call passes it as handle only one lookup is needed per
+ * step; otherwise both handles are resolved in the same table pass.
+ */
+void* rma_getPtrPrefetchNext(struct rma_mem_header_t *header, rma_handle_t handle, rma_handle_t nextHandle);
+
+/**
+ * @brief Maximum nesting depth of allocation transactions per thread
+ */
+#define RMA_TX_MAX_DEPTH 16
+
+/**
+ * @brief Open an allocation transaction on the calling thread
+ * @return 1 on success, 0 if RMA_TX_MAX_DEPTH nested transactions are already open
+ *
+ * @note Transactions are per thread and span every pool the thread allocates from
+ * @see rma_txCommit, rma_txAbort
+ *
+ * While a transaction is open, every successful rma_alloc() on this thread
+ * is appended to a compact per-thread log of (pool, handle) pairs. Nesting
+ * only pushes the current log position, so it costs one store. Outside a
+ * transaction the allocator pays a single thread-local depth check.
+ */
+int rma_txBegin(void);
+
+/**
+ * @brief Commit the innermost transaction of the calling thread
+ * @return 1 on success, 0 if no transaction is open
+ *
+ * @see rma_txBegin, rma_txAbort
+ *
+ * Keeps all allocations. A nested commit hands its allocations to the
+ * enclosing transaction (so an outer abort still frees them); committing
+ * the outermost transaction just drops the log.
+ */
+int rma_txCommit(void);
+
+/**
+ * @brief Abort the innermost transaction and free everything it allocated
+ * @return Number of blocks freed
+ *
+ * @warning Handles allocated inside the transaction become invalid
+ * @see rma_txBegin, rma_txCommit
+ *
+ * Frees the logged allocations in one batch per pool: the logged salts are
+ * sorted once and the pool is swept a single time, instead of paying an
+ * O(n) handle lookup per rma_free(). Blocks already freed inside the
+ * transaction are skipped.
+ */
+size_t rma_txAbort(void);
+
+/**
+ * @brief Number of free-run length buckets in struct rma_stats_t
+ *
+ * Bucket i counts runs of 2^i to 2^(i+1) - 1 free blocks, the last bucket
+ * everything longer.
+ */
+#define RMA_STATS_RUN_BUCKETS 16
+
+/**
+ * @brief Number of request size buckets in struct rma_stats_t
+ *
+ * Bucket i counts rma_allocSized() requests of 2^i to 2^(i+1) - 1 bytes.
+ */
+#define RMA_STATS_SIZE_BUCKETS 32
+
+/**
+ * @brief Point-in-time statistics of a pool
+ */
+struct rma_stats_t {
+    size_t totalSize;        /**< Total pool size in bytes */
+    size_t blockSize;        /**< Usable bytes per block */
+    size_t numBlocks;        /**< Number of allocatable blocks */
+    size_t numAllocated;     /**< Allocated blocks */
+    size_t usedSize;         /**< Used bytes (metadata plus allocated blocks) */
+    size_t numTimers;        /**< Blocks with a pending expiry */
+    size_t numIndexed;       /**< Blocks in the dedup content index */
+    size_t numAliases;       /**< Handles sharing another handle's block */
+    size_t freeRuns;         /**< Maximal runs of consecutive free blocks */
+    size_t largestFreeRun;   /**< Length of the longest free run in blocks */
+    size_t runHistogram[RMA_STATS_RUN_BUCKETS]; /**< Free runs by length (see RMA_STATS_RUN_BUCKETS) */
+    size_t sizedBlocks;      /**< Allocated blocks with a size recorded by rma_allocSized() */
+    size_t requestedBytes;   /**< Sum of the recorded sizes */
+    size_t wastedBytes;      /**< Internal fragmentation: sizedBlocks * blockSize - requestedBytes */
+    size_t sizeHistogram[RMA_STATS_SIZE_BUCKETS]; /**< Recorded sizes by magnitude (see RMA_STATS_SIZE_BUCKETS) */
+    size_t lockStripes;      /**< Stripes of the rma_lock() table (0 = none) */
+    size_t lockAcquisitions; /**< rma_lock() calls that took a lock */
+    size_t lockContended;    /**< rma_lock() calls that found their stripe held */
+};
+
+/**
+ * @brief Take a statistics snapshot without taking the pool lock
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param stats Output structure (must not be NULL)
+ * @return 1 on success, 0 on NULL arguments
+ *
+ * @note Counters are read individually, so a snapshot taken during
+ *       allocations may mix values from a few operations apart
+ * @see rma_registerPool
+ *
+ * Safe to call from any thread while other threads allocate: counters
+ * and bitmap words are updated with single atomic stores by the thread
+ * holding the pool lock and read here with atomic loads, so querying
+ * never stalls allocators. Free runs are found by scanning the bitmap a
+ * word at a time. External fragmentation is 1 - largestFreeRun / free blocks.
+ * With options.sizeTracking the recorded sizes of the allocated blocks are
+ * summed up as well; internal fragmentation is wastedBytes divided by
+ * sizedBlocks * blockSize.
+ */
+int rma_getStats(struct rma_mem_header_t *header, struct rma_stats_t *stats);
+
+/**
+ * @brief Return the memory of free blocks to the operating system
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @return Number of bytes released
+ *
+ * @see rma_shrinkToFit
+ *
+ * Releases the whole pages covered by free blocks with MADV_DONTNEED,
+ * without moving blocks or changing capacity. malloc-backed pools cannot
+ * return memory, so 0 is reported.
+ */
+size_t rma_trim(struct rma_mem_header_t *header);
+
+/**
+ * @brief Maximum number of pools rma_registerPool() can list at once
+ */
+#define RMA_REGISTRY_MAX 64
+
+/**
+ * @brief Maximum length of a registered pool name, including the terminator
+ */
+#define RMA_POOL_NAME_MAX 32
+
+/**
+ * @brief Function called by rma_forEachPool() for every registered pool
+ */
+typedef void (*rma_pool_visitor_t)(struct rma_mem_header_t *header, char const *name, void *context);
+
+/**
+ * @brief Make a pool visible to process-wide tooling such as the introspection server
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param name Pool name, truncated to RMA_POOL_NAME_MAX - 1 characters (must not be NULL)
+ * @return 1 on success, 0 if the pool is already registered or the registry is full
+ *
+ * @see rma_unregisterPool, rma_forEachPool, rma_introspectStart
+ *
+ * rma_destroy() unregisters the pool, and rma_resize() updates the entry
+ * when the pool moves. Both wait for a running rma_forEachPool() visit, so
+ * a visitor never sees a pool being destroyed or relocated.
+ */
+int rma_registerPool(struct rma_mem_header_t *header, char const *name);
+
+/**
+ * @brief Remove a pool from the registry
+ * @param header Pointer to a registered RMA header
+ * @return 1 if the pool was registered, 0 otherwise
+ */
+int rma_unregisterPool(struct rma_mem_header_t *header);
+
+/**
+ * @brief Call a function for every registered pool
+ * @param visitor Function to call (must not be NULL)
+ * @param context Passed through to the visitor
+ * @return Number of pools visited
+ *
+ * @warning The registry is locked during the visit, the visitor must not
+ *          register, unregister, resize or destroy pools
+ */
+size_t rma_forEachPool(rma_pool_visitor_t visitor, void *context);
+
+/**
+ * @brief Width of the images written by rma_dumpHeatmap() in pixels
+ */
+#define RMA_HEATMAP_WIDTH 256
+
+/**
+ * @brief Upper bound on the pixels of one heatmap frame (256 x 256)
+ */
+#define RMA_HEATMAP_MAX_PIXELS 65536
+
+/**
+ * @brief Memory each heatmap pixel covers at least, in bytes
+ */
+#define RMA_HEATMAP_PAGE 4096
+
+/**
+ * @brief Write the block bitmap as a downsampled occupancy image
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param fd File descriptor to write the frame to
+ * @return 1 on success, 0 on NULL header or write failure
+ *
+ * @see rma_heatmapStart, rma_getStats
+ *
+ * Each pixel covers the blocks of at least one RMA_HEATMAP_PAGE (more for
+ * pools that would exceed RMA_HEATMAP_MAX_PIXELS) and its gray value is
+ * their occupancy: 0 all free, 255 all allocated. Pixels are laid out row
+ * by row, RMA_HEATMAP_WIDTH per row; padding after the last block is 0.
+ *
+ * The frame is a binary PGM (P5) image with a comment line
+ * `# rma blocks=<n> blocksPerPixel=<g> pixels=<p> allocated=<a>`, written
+ * with a single write() where possible. Frames appended to the same file
+ * form a multi-image PGM stream that netpbm tools and ffmpeg
+ * (`-f image2pipe -c:v pgm`) can replay.
+ *
+ * The bitmap is read a word at a time with atomic loads and no lock, like
+ * rma_getStats(), so a frame of a million-block pool costs about as much
+ * as counting 32k words.
+ */
+int rma_dumpHeatmap(struct rma_mem_header_t *header, int fd);
+
+/**
+ * @brief Build the frame rma_dumpHeatmap() would write into a buffer
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param size Receives the frame size in bytes (must not be NULL)
+ * @return The frame, to be released with free(), or NULL on NULL arguments or allocation failure
+ *
+ * @see rma_dumpHeatmap
+ *
+ * Lets a caller that holds a lock (e.g. inside rma_forEachPool()) take the
+ * frame quickly and write it once the lock is released.
+ */
+unsigned char* rma_renderHeatmap(struct rma_mem_header_t *header, size_t *size);
+
+/**
+ * @brief Maximum number of pools the warm pool cache holds
+ */
+#define RMA_POOL_CACHE_MAX 32
+
+/**
+ * @brief Set the cap on memory kept by the warm pool cache
+ * @param maxBytes New cap in bytes (0 disables the cache)
+ * @return Previous cap
+ *
+ * @see rma_destroy, rma_memHeaderInitEx, rma_drainPoolCache
+ *
+ * The cache is off (cap 0) until this is called. With a nonzero cap,
+ * rma_destroy() parks malloc- and mmap-backed pools in a process-wide
+ * cache instead of releasing them, as long as the cached bytes stay within
+ * the cap. The next rma_memHeaderInitEx() with the same totalSize and
+ * blockSize, and options that obtain memory the same way (backing,
+ * hugePages, alignment), takes a parked pool: no allocation, no page
+ * faults on already touched blocks, and only the header is rewritten
+ * because the metadata was cleared when the pool was parked. The reused
+ * pool's handle counter carries on from its previous life, so stale
+ * handles of the destroyed pool are not handed out again right away.
+ *
+ * Lowering the cap releases parked pools until the rest fits.
+ */
+size_t rma_setPoolCacheLimit(size_t maxBytes);
+
+/**
+ * @brief Release every pool parked in the warm pool cache
+ * @return Number of pools released
+ *
+ * @see rma_setPoolCacheLimit
+ *
+ * Returns the parked memory with free() or munmap() and leaves the cap
+ * alone, so later rma_destroy() calls keep parking pools.
+ */
+size_t rma_drainPoolCache(void);
+
 /**
  * @brief Display comprehensive memory pool statistics
  * @param header Pointer to initialized RMA header (must not be NULL)
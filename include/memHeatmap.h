@@ -0,0 +1,46 @@
+/**
+ * @file memHeatmap.h
+ * @brief Periodic heatmap recording of a registered pool
+ * @author Robkoo
+ * @date 18.10.2026
+ * @version 0.0.3
+ * @since 0.0.3
+ *
+ * Appends an rma_dumpHeatmap() frame to a file at a fixed interval from a
+ * background thread, so the evolution of fragmentation in a long-running
+ * service can be replayed afterwards.
+ */
+
+#ifndef MEM_HEATMAP
+#define MEM_HEATMAP
+
+#include "memHeader.h"
+
+/**
+ * @brief Shortest accepted recording interval in milliseconds
+ */
+#define RMA_HEATMAP_MIN_INTERVAL 10
+
+/**
+ * @brief Start recording heatmap frames of a registered pool
+ * @param poolName Name the pool was registered under with rma_registerPool() (must not be NULL)
+ * @param fd File descriptor the frames are appended to, stays owned by the caller
+ * @param intervalMs Time between frames, at least RMA_HEATMAP_MIN_INTERVAL
+ * @return 1 on success, 0 if a recording is already running or the arguments are invalid
+ *
+ * @see rma_heatmapStop, rma_dumpHeatmap
+ *
+ * The first frame is written immediately. The pool is looked up by name
+ * through rma_forEachPool() for every frame, so it may be resized while
+ * recording; frames stop silently while no pool of that name is
+ * registered and resume once it is.
+ */
+int rma_heatmapStart(char const *poolName, int fd, unsigned intervalMs);
+
+/**
+ * @brief Stop the running heatmap recording
+ * @return Number of frames written, 0 if no recording was running
+ */
+size_t rma_heatmapStop(void);
+
+#endif // MEM_HEATMAP
@@ -0,0 +1,71 @@
+/**
+ * @file memIntrospect.h
+ * @brief Live introspection of registered pools over a Unix domain socket
+ * @author Robkoo
+ * @date 18.10.2026
+ * @version 0.0.3
+ * @since 0.0.3
+ *
+ * Runs an optional server thread that answers line-based text queries
+ * about every pool listed with rma_registerPool(), so a running process
+ * can be inspected with `nc -U` or `socat` instead of a debugger.
+ */
+
+#ifndef MEM_INTROSPECT
+#define MEM_INTROSPECT
+
+#include "memHeader.h"
+
+/**
+ * @brief Maximum number of clients served at the same time
+ */
+#define RMA_INTROSPECT_MAX_CLIENTS 8
+
+/**
+ * @brief Maximum length of one request line
+ */
+#define RMA_INTROSPECT_LINE_MAX 256
+
+/**
+ * @brief Start the introspection server
+ * @param socketPath Filesystem path of the listening socket (must not be NULL)
+ * @param snapshotDir Existing directory snapshots are written to, or NULL to refuse `snapshot`
+ * @return 1 on success, 0 if a server is already running, socketPath is
+ *         taken by something other than a socket, snapshotDir is not a
+ *         directory or the socket can't be created
+ *
+ * @note A stale socket at socketPath is replaced; any other file there is left alone
+ * @see rma_introspectStop, rma_registerPool
+ *
+ * Every request is one line, every response ends with an empty line:
+ * - `help` lists the commands
+ * - `pools` lists the registered pools
+ * - `stats [pool]` prints the counters of rma_getStats()
+ * - `frag [pool]` prints free runs and external fragmentation
+ * - `histogram [pool]` prints the free-run length histogram
+ * - `sizes [pool]` prints internal fragmentation and the rma_allocSized() size histogram
+ * - `trim <pool>` runs rma_trim()
+ * - `compact <pool>` runs rma_compact()
+ * - `snapshot <pool>` writes an rma_clone() of the pool to a new file
+ *   `<snapshotDir>/<pool>.<n>.rma` and prints its path
+ *
+ * Queries without a pool name cover all pools and read the lock-free
+ * rma_getStats() snapshot, so they never stall allocators. trim, compact
+ * and snapshot change or copy the pool and are only accepted for pools
+ * created with options.threadSafe.
+ *
+ * Clients can't choose where a snapshot goes: the file is created with
+ * O_EXCL and O_NOFOLLOW and mode 0600 inside snapshotDir, so a request
+ * never overwrites or follows a link to an existing file.
+ */
+int rma_introspectStart(char const *socketPath, char const *snapshotDir);
+
+/**
+ * @brief Stop the introspection server
+ *
+ * Disconnects all clients, joins the server thread and removes the
+ * socket file. Does nothing if no server is running.
+ */
+void rma_introspectStop(void);
+
+#endif // MEM_INTROSPECT
@@ -0,0 +1,52 @@
+/**
+ * @file memProbes.h
+ * @brief USDT static tracepoints of the allocator
+ * @author Robkoo
+ * @date 18.10.2026
+ * @version 0.0.3
+ * @since 0.0.3
+ *
+ * Wraps the SystemTap/DTrace `sys/sdt.h` probe macros. A probe site is a
+ * single nop plus a note in the ELF file until bpftrace or perf attaches
+ * to it, so the probes stay compiled in for production builds. Without
+ * `sys/sdt.h` (or with RMA_NO_PROBES defined) every probe compiles to
+ * nothing. Sample bpftrace scripts live in `scripts/`.
+ *
+ * Probes (provider `rma`, arguments in order):
+ * - `alloc_start(pool)` - an allocation function (rma_alloc(), rma_allocSized(),
+ *   rma_allocValue(), rma_allocWait(), rma_allocWithTTL(), rma_allocOrEvict()) entered
+ * - `alloc_done(pool, handle, size)` - it returned, handle 0 on failure
+ * - `alloc_fail(pool, numAllocated, numBlocks)` - no free block was left
+ * - `free(pool, handle, result)` - rma_free() returned result
+ * - `getptr_fail(pool, handle, validity)` - rma_getPtr() rejected a handle
+ * - `resize(pool, newPool, oldSize, newSize)` - rma_resize() grew or shrank a pool
+ * - `compact(pool, moved)` - rma_compact() moved blocks
+ * - `trim(pool, released)` - rma_trim() or rma_shrinkToFit() gave bytes back
+ */
+
+#ifndef MEM_PROBES
+#define MEM_PROBES
+
+#if !defined(RMA_NO_PROBES) && __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+
+/**
+ * @brief Fire the USDT probe rma:name with up to ten integer or pointer arguments
+ */
+#define RMA_PROBE(name, ...) STAP_PROBEV(rma, name, __VA_ARGS__)
+
+#else
+
+/**
+ * @brief Swallows the probe arguments, only ever named inside sizeof and never defined
+ */
+int rma_probeArgs(void const *pool, ...);
+
+/**
+ * @brief Probes are compiled out, the arguments are referenced but not evaluated
+ */
+#define RMA_PROBE(name, ...) ((void)sizeof(rma_probeArgs(__VA_ARGS__)))
+
+#endif
+
+#endif // MEM_PROBES
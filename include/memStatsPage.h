@@ -0,0 +1,116 @@
+/**
+ * @file memStatsPage.h
+ * @brief Shared-memory statistics pages read by rma-top
+ * @author Robkoo
+ * @date 18.10.2026
+ * @version 0.0.3
+ * @since 0.0.3
+ *
+ * A published pool mirrors its counters into a small file under
+ * RMA_STATS_PAGE_DIR that any process on the host can map read-only.
+ * The pool lock holder updates the page in place; readers never touch
+ * the pool, so monitoring costs the allocator nothing but the stores.
+ */
+
+#ifndef MEM_STATS_PAGE
+#define MEM_STATS_PAGE
+
+#include "memHeader.h"
+
+/**
+ * @brief Directory the stats pages are created in (tmpfs, never hits a disk)
+ */
+#define RMA_STATS_PAGE_DIR "/dev/shm"
+
+/**
+ * @brief File name prefix of stats pages, followed by `<pid>.<pool name>`
+ */
+#define RMA_STATS_PAGE_PREFIX "rma."
+
+/**
+ * @brief First word of every stats page ("RMAS")
+ */
+#define RMA_STATS_PAGE_MAGIC 0x524D4153u
+
+/**
+ * @brief Layout version of struct rma_stats_page_t
+ */
+#define RMA_STATS_PAGE_VERSION 1
+
+/**
+ * @brief Number of allocation latency buckets, bucket i counts calls of 2^i to 2^(i+1) - 1 ns
+ */
+#define RMA_LATENCY_BUCKETS 32
+
+/**
+ * @brief Block claims/releases between two free-run rescans of a published pool
+ *
+ * The occupancy counters are exact, the fragmentation fields lag by at
+ * most this many operations. Rescanning costs one word load per 32 blocks.
+ */
+#define RMA_STATS_PAGE_SCAN_PERIOD 1024
+
+/**
+ * @brief Contents of a stats page
+ *
+ * The occupancy block is protected by a seqlock: the writer makes
+ * sequence odd, updates the fields and makes it even again, and readers
+ * retry while it is odd or changed under them (see rma_readStatsPage()).
+ * The latency histogram only grows and is updated with atomic adds, so it
+ * needs no sequence.
+ */
+struct rma_stats_page_t {
+    uint32_t magic;          /**< RMA_STATS_PAGE_MAGIC */
+    uint32_t version;        /**< RMA_STATS_PAGE_VERSION */
+    int32_t pid;             /**< Process owning the pool */
+    uint32_t reserved;       /**< Keeps the name 8-byte aligned */
+    char name[RMA_POOL_NAME_MAX]; /**< Pool name given to rma_publishStats() */
+
+    _Alignas(64) uint64_t sequence; /**< Seqlock counter, odd while an update is in progress */
+    uint64_t totalSize;      /**< Total pool size in bytes */
+    uint64_t blockSize;      /**< Usable bytes per block */
+    uint64_t numBlocks;      /**< Number of allocatable blocks */
+    uint64_t numAllocated;   /**< Allocated blocks */
+    uint64_t allocs;         /**< Blocks claimed from the pool since publishing */
+    uint64_t frees;          /**< Blocks returned to the pool since publishing */
+    uint64_t freeRuns;       /**< Free runs at the last rescan */
+    uint64_t largestFreeRun; /**< Longest free run at the last rescan */
+    uint64_t updates;        /**< Updates since the last rescan */
+
+    _Alignas(64) uint64_t latency[RMA_LATENCY_BUCKETS]; /**< Allocation calls by log2 of their latency in ns */
+};
+
+/**
+ * @brief Publish a pool's statistics in a shared-memory page
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param name Pool name, truncated to RMA_POOL_NAME_MAX - 1 characters (must not be NULL)
+ * @return 1 on success, 0 if the pool is already published or the page can't be created
+ *
+ * @note Publishing adds one clock read to every allocation call for the latency histogram
+ * @see rma_unpublishStats, rma_readStatsPage
+ *
+ * Creates RMA_STATS_PAGE_DIR/RMA_STATS_PAGE_PREFIX<pid>.<name>. From then
+ * on every block claim and release updates the page; rma_destroy()
+ * removes it. Pages of crashed processes are left behind and recognized
+ * by rma-top through their dead pid.
+ */
+int rma_publishStats(struct rma_mem_header_t *header, char const *name);
+
+/**
+ * @brief Stop publishing a pool's statistics and remove its page
+ * @param header Pointer to initialized RMA header
+ */
+void rma_unpublishStats(struct rma_mem_header_t *header);
+
+/**
+ * @brief Take a consistent copy of a (possibly foreign) stats page
+ * @param page Mapped page, typically read-only (must not be NULL)
+ * @param copy Output copy (must not be NULL)
+ * @return 1 on success, 0 if the page is not a valid stats page
+ *
+ * Retries while the writer is in the middle of an update, so the
+ * occupancy fields of the copy always belong to the same update.
+ */
+int rma_readStatsPage(struct rma_stats_page_t const *page, struct rma_stats_page_t *copy);
+
+#endif // MEM_STATS_PAGE
@@ -11,30 +11,138 @@
  * testing, and proper cleanup procedures.
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include "memHeader.h"
+#include "memConfig.h"
+#include "memHeatmap.h"
+#include "memIntrospect.h"
+#include "memStatsPage.h"
 
 // THIS PROJECT'S IDENTIFIER IS `RMA` - Robkoo's Memory Allocator.
 // IT **WILL** BE PUT IN FRONT OF ALL FUNCTIONS, DEFINITIONS AND CUSTOM TYPES FOR CLARITY
 
 /**
- * @brief Default memory arena size for testing
- * 
- * Initial memory pool size of 1 MiB provides sufficient space for
- * testing allocation patterns while remaining manageable for debugging.
+ * @brief Name of the test pool in rma.conf / RMA_<NAME>_* variables
+ *
+ * Without a config file the pool uses RMA_DEFAULT_TOTAL_SIZE (1 MiB) and
+ * RMA_DEFAULT_BLOCK_SIZE (1 KiB); set e.g. RMA_TEST_BLOCK_SIZE=4K to tune
+ * it without recompiling.
  */
-#define STARTING_ARENA_SIZE (1024 * 1024) // 1 MiB
+#define TEST_POOL_NAME "test"
 
 /**
- * @brief Default block size for memory allocations
- * 
- * 1 KiB blocks provide a good balance between granularity and
- * metadata overhead for typical application usage patterns.
+ * @brief Block freed by delayedFree() once it wakes up
+ */
+struct test_delayed_free_t {
+    struct rma_mem_header_t *pool; /**< Pool to free from */
+    rma_handle_t handle;           /**< Block to free */
+};
+
+/**
+ * @brief Thread entry that frees a block after a short delay
+ * @param argument Pointer to struct test_delayed_free_t
+ * @return NULL
+ */
+static void* delayedFree(void *argument){
+    struct test_delayed_free_t const *request = argument;
+
+    struct timespec const delay = { 0, 50 * 1000000 }; // 50 ms
+    nanosleep(&delay, NULL);
+    rma_free(request->pool, request->handle);
+
+    return NULL;
+}
+
+/**
+ * @brief Blocks keepOnExpire() saves from expiring
+ */
+struct test_expiry_keep_t {
+    rma_handle_t rearmed;   /**< Given another 1000 ticks */
+    rma_handle_t cancelled; /**< Made permanent */
+};
+
+/**
+ * @brief rma_expire() callback that re-arms or cancels selected blocks
+ * @param pool Pool the block belongs to
+ * @param handle Expiring block
+ * @param context Pointer to struct test_expiry_keep_t
+ */
+static void keepOnExpire(struct rma_mem_header_t *pool, rma_handle_t handle, void *context){
+    struct test_expiry_keep_t const *keep = context;
+
+    if (handle == keep->rearmed) rma_setTTL(pool, handle, 1000);
+    else if (handle == keep->cancelled) rma_setTTL(pool, handle, 0);
+}
+
+/**
+ * @brief Block counter incremented by lockedIncrements()
  */
-#define DEFAULT_BLOCK_SIZE (1024) // 1KiB blocks
+struct test_locked_counter_t {
+    struct rma_mem_header_t *pool; /**< Pool with lock stripes */
+    rma_handle_t handle;           /**< Block holding the counter */
+    int rounds;                    /**< Increments per thread */
+};
+
+/**
+ * @brief Thread entry that increments a block counter under rma_lock()
+ * @param argument Pointer to struct test_locked_counter_t
+ * @return NULL
+ */
+static void* lockedIncrements(void *argument){
+    struct test_locked_counter_t const *counter = argument;
+    unsigned long *value = rma_getPtr(counter->pool, counter->handle);
+
+    for (int i = 0; i < counter->rounds; i++){
+        rma_lock(counter->pool, counter->handle);
+        (*value)++;
+        rma_unlock(counter->pool, counter->handle);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Send one request to the introspection server and read its response
+ * @param socketPath Path of the server socket
+ * @param request Request line including the trailing newline
+ * @param response Buffer receiving the response
+ * @param size Size of the response buffer
+ * @return 1 if a complete response (ending in an empty line) arrived, 0 otherwise
+ */
+static int introspectQuery(char const *socketPath, char const *request, char *response, size_t size){
+    struct sockaddr_un address = { .sun_family = AF_UNIX };
+    snprintf(address.sun_path, sizeof(address.sun_path), "%s", socketPath);
+
+    int const fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return 0;
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0 || write(fd, request, strlen(request)) < 0){
+        close(fd);
+        return 0;
+    }
+
+    size_t length = 0;
+    response[0] = '\0';
+    while (length < size - 1 && (length < 2 || strcmp(response + length - 2, "\n\n") != 0)){
+        ssize_t const received = read(fd, response + length, size - 1 - length);
+        if (received <= 0) break;
+        length += (size_t)received;
+        response[length] = '\0';
+    }
+
+    close(fd);
+    return length >= 2 && strcmp(response + length - 2, "\n\n") == 0;
+}
 
 /**
  * @brief Main test function for RMA memory allocator
@@ -51,7 +159,7 @@ int main(void){
     srand(time(NULL));
 
     // Initialize memory pool
-    struct rma_mem_header_t *allocator = rma_memHeaderInit(STARTING_ARENA_SIZE, DEFAULT_BLOCK_SIZE);
+    struct rma_mem_header_t *allocator = rma_createFromConfig(TEST_POOL_NAME);
     
     if (!allocator){
         printf("Failed to initialize RMA!\n");
@@ -170,27 +278,28 @@ int main(void){
     char *boundary_ptr = (char*)rma_getPtr(allocator, boundary_handle);
 
     if (boundary_ptr){
-        printf("Testing full block write/read (%d bytes)...\n", DEFAULT_BLOCK_SIZE);
+        size_t const blockSize = allocator->blockSize;
+        printf("Testing full block write/read (%zu bytes)...\n", blockSize);
         
         // Fill the entire block with a pattern
-        for (size_t i = 0; i < DEFAULT_BLOCK_SIZE; i++){
+        for (size_t i = 0; i < blockSize; i++){
             boundary_ptr[i] = (char)(i % 256);
         }
         
         // Verify the pattern
         int errors = 0;
-        for (size_t i = 0; i < DEFAULT_BLOCK_SIZE; i++){
+        for (size_t i = 0; i < blockSize; i++){
             if (boundary_ptr[i] != (char)(i % 256)){
                 errors++;
             }
         }
         
         if (errors == 0){
-            printf("[SUCCESS] Block boundaries test passed - wrote/read %d bytes successfully\n", DEFAULT_BLOCK_SIZE);
+            printf("[SUCCESS] Block boundaries test passed - wrote/read %zu bytes successfully\n", blockSize);
             printf("   First byte: %d, Middle byte: %d, Last byte: %d\n", 
                    (unsigned char)boundary_ptr[0], 
-                   (unsigned char)boundary_ptr[511], 
-                   (unsigned char)boundary_ptr[1023]);
+                   (unsigned char)boundary_ptr[blockSize / 2 - 1], 
+                   (unsigned char)boundary_ptr[blockSize - 1]);
         }
         else {
             printf("[ERR] Block boundaries test failed - %d errors detected\n", errors);
@@ -229,6 +338,774 @@ int main(void){
         printf("[ERR] Failed to allocate after fragmentation\n");
     }
 
+    // ========================================
+    // Test 6: Config & Environment Test
+    // ========================================
+    printf("\n=== Test 6: Config & Environment ===\n");
+
+    // pool specific variables override the global ones
+    setenv("RMA_BLOCK_SIZE", "512", 1);
+    setenv("RMA_CONFIG_TEST_BLOCK_SIZE", "2K", 1);
+    setenv("RMA_CONFIG_TEST_BACKING", "mmap", 1);
+
+    struct rma_mem_header_t *configured = rma_createFromConfig("config-test");
+    if (configured && configured->blockSize == 2048 && configured->backing == RMA_BACKING_MMAP){
+        printf("[SUCCESS] Environment configured a 2 KiB block, mmap backed pool\n");
+    }
+    else {
+        printf("[ERR] Environment configuration was not applied!\n");
+    }
+    rma_destroy(configured);
+
+    // a suffix that overflows size_t is rejected instead of wrapping into a small pool
+    struct rma_config_t overflowed;
+    setenv("RMA_CONFIG_TEST_TOTAL_SIZE", "99999999999G", 1);
+    if (rma_loadConfig("config-test", &overflowed) == 0){
+        printf("[SUCCESS] Overflowing size 99999999999G rejected\n");
+    }
+    else {
+        printf("[ERR] Overflowing size accepted as %zu bytes!\n", overflowed.totalSize);
+    }
+    unsetenv("RMA_CONFIG_TEST_TOTAL_SIZE");
+
+    unsetenv("RMA_BLOCK_SIZE");
+    unsetenv("RMA_CONFIG_TEST_BLOCK_SIZE");
+    unsetenv("RMA_CONFIG_TEST_BACKING");
+
+    // ========================================
+    // Test 7: Epoch Bulk Free Test
+    // ========================================
+    printf("\n=== Test 7: Epoch Bulk Free ===\n");
+
+    struct rma_options_t epochOptions = { .epochTags = 1 };
+    struct rma_mem_header_t *epochPool = rma_memHeaderInitEx(64 * 1024, 256, &epochOptions);
+
+    // long-lived blocks interleaved with request-scoped ones
+    rma_handle_t longLived = rma_alloc(epochPool);
+    uint32_t const epoch = rma_beginEpoch(epochPool);
+    rma_handle_t scoped[40];
+    for (int i = 0; i < 40; i++){
+        scoped[i] = rma_alloc(epochPool);
+        if (i == 20){
+            // allocations outside the epoch are not tagged
+            rma_endEpoch(epochPool);
+            longLived = rma_alloc(epochPool);
+            rma_beginEpoch(epochPool);
+        }
+    }
+    uint32_t const secondEpoch = epochPool->currentEpoch;
+
+    size_t const freedBlocks = rma_freeEpoch(epochPool, epoch) + rma_freeEpoch(epochPool, secondEpoch);
+    if (freedBlocks == 40 && epochPool->numAllocated == 2 && rma_getPtr(epochPool, longLived) && !rma_getPtr(epochPool, scoped[0])){
+        printf("[SUCCESS] Freed %zu epoch blocks, long-lived blocks survived\n", freedBlocks);
+    }
+    else {
+        printf("[ERR] Epoch sweep freed %zu blocks, %zu still allocated\n", freedBlocks, epochPool->numAllocated);
+    }
+    rma_destroy(epochPool);
+
+    // ========================================
+    // Test 8: Transaction Rollback Test
+    // ========================================
+    printf("\n=== Test 8: Transaction Rollback ===\n");
+
+    size_t const allocatedBeforeTx = allocator->numAllocated;
+    rma_handle_t committed = RMA_INVALID_HANDLE;
+
+    rma_txBegin();
+    rma_alloc(allocator);
+    rma_handle_t freedInTx = rma_alloc(allocator);
+    rma_free(allocator, freedInTx);
+
+    // the nested commit hands its block to the outer transaction
+    rma_txBegin();
+    rma_alloc(allocator);
+    rma_txCommit();
+
+    size_t const rolledBack = rma_txAbort();
+
+    rma_txBegin();
+    committed = rma_alloc(allocator);
+    rma_txCommit();
+
+    if (rolledBack == 2 && allocator->numAllocated == allocatedBeforeTx + 1 && rma_getPtr(allocator, committed)){
+        printf("[SUCCESS] Abort freed %zu blocks, committed block survived\n", rolledBack);
+    }
+    else {
+        printf("[ERR] Abort freed %zu blocks, %zu allocated (expected %zu)\n",
+               rolledBack, allocator->numAllocated, allocatedBeforeTx + 1);
+    }
+    rma_free(allocator, committed);
+
+    // ========================================
+    // Test 9: Pool Clone Test
+    // ========================================
+    printf("\n=== Test 9: Pool Clone ===\n");
+
+    struct rma_mem_header_t *cloned = rma_clone(allocator);
+    char *original = (char*)rma_getPtr(allocator, h4);
+    char *copied = cloned ? (char*)rma_getPtr(cloned, h4) : NULL;
+
+    if (copied && original && copied != original && strcmp(copied, original) == 0 &&
+        cloned->numAllocated == allocator->numAllocated){
+        printf("[SUCCESS] Handle resolves to '%s' in the clone\n", copied);
+    }
+    else {
+        printf("[ERR] Clone does not match the original pool!\n");
+    }
+    rma_destroy(cloned);
+
+    // ========================================
+    // Test 10: Pool Resize Test
+    // ========================================
+    printf("\n=== Test 10: Pool Resize ===\n");
+
+    struct rma_options_t mmapOptions = { .backing = RMA_BACKING_MMAP };
+    struct rma_mem_header_t *resizable = rma_memHeaderInitEx(64 * 1024, 256, &mmapOptions);
+    rma_handle_t kept = rma_alloc(resizable);
+    strcpy((char*)rma_getPtr(resizable, kept), "Survives resizing!");
+    size_t const smallBlocks = resizable->numBlocks;
+
+    // grow (the mapping may move), then shrink back in place
+    struct rma_mem_header_t *grown = rma_resize(resizable, 1024 * 1024);
+    if (grown) resizable = grown;
+    int const grewOk = grown && resizable->numBlocks > smallBlocks && strcmp((char*)rma_getPtr(resizable, kept), "Survives resizing!") == 0;
+
+    struct rma_mem_header_t *shrunk = rma_resize(resizable, 64 * 1024);
+    if (shrunk) resizable = shrunk;
+    int const shrankOk = shrunk && resizable->numBlocks == smallBlocks && strcmp((char*)rma_getPtr(resizable, kept), "Survives resizing!") == 0;
+
+    if (grewOk && shrankOk){
+        printf("[SUCCESS] Handle survived growing and shrinking the pool\n");
+    }
+    else {
+        printf("[ERR] Resize lost data (grow: %d, shrink: %d)\n", grewOk, shrankOk);
+    }
+    rma_destroy(resizable);
+
+    // ========================================
+    // Test 11: Compaction & Shrink-To-Fit Test
+    // ========================================
+    printf("\n=== Test 11: Compaction & Shrink-To-Fit ===\n");
+
+    struct rma_mem_header_t *fragmented = rma_memHeaderInitEx(1024 * 1024, 4096, &mmapOptions);
+    rma_handle_t blocks[200];
+    for (int i = 0; i < 200; i++){
+        blocks[i] = rma_alloc(fragmented);
+        *(int*)rma_getPtr(fragmented, blocks[i]) = i;
+    }
+
+    // keep every tenth block, pin one of them where it is
+    for (int i = 0; i < 200; i++){
+        if (i % 10 != 0) rma_free(fragmented, blocks[i]);
+    }
+    int *pinnedPtr = (int*)rma_getPtr(fragmented, blocks[100]);
+    rma_pin(fragmented, blocks[100]);
+
+    size_t const returnedBytes = rma_shrinkToFit(fragmented, 0);
+
+    int intact = 1;
+    for (int i = 0; i < 200; i += 10){
+        int *value = (int*)rma_getPtr(fragmented, blocks[i]);
+        if (!value || *value != i) intact = 0;
+    }
+
+    if (intact && returnedBytes > 0 && rma_getPtr(fragmented, blocks[100]) == pinnedPtr && fragmented->numBlocks <= 101){
+        printf("[SUCCESS] Returned %zu bytes, %zu blocks left, data and pinned block intact\n", returnedBytes, fragmented->numBlocks);
+    }
+    else {
+        printf("[ERR] Shrink-to-fit failed (intact: %d, returned: %zu, blocks: %zu)\n", intact, returnedBytes, fragmented->numBlocks);
+    }
+    rma_destroy(fragmented);
+
+    // ========================================
+    // Test 12: Prefetch Test
+    // ========================================
+    printf("\n=== Test 12: Prefetch ===\n");
+
+    rma_handle_t chain[8];
+    void *resolved[8];
+    for (int i = 0; i < 8; i++) chain[i] = rma_alloc(allocator);
+
+    size_t const foundCount = rma_prefetchBatch(allocator, chain, 8, resolved, RMA_PREFETCH_READ, 3);
+
+    // a handle that only shares a live block's salt is not found
+    rma_handle_t const forged[2] = { chain[0], chain[0] ^ 1 };
+    int resolvedOk = foundCount == 8 && rma_prefetchBatch(allocator, forged, 2, NULL, RMA_PREFETCH_READ, 3) == 1;
+    for (int i = 0; i < 8; i++){
+        if (resolved[i] != rma_getPtr(allocator, chain[i])) resolvedOk = 0;
+        rma_handle_t const next = i + 1 < 8 ? chain[i + 1] : RMA_INVALID_HANDLE;
+        if (rma_getPtrPrefetchNext(allocator, chain[i], next) != resolved[i]) resolvedOk = 0;
+    }
+
+    if (resolvedOk && rma_prefetch(allocator, chain[0], RMA_PREFETCH_WRITE, 1) && !rma_prefetch(allocator, RMA_INVALID_HANDLE, 0, 0)){
+        printf("[SUCCESS] Batch and pipelined prefetch resolved all %zu handles\n", foundCount);
+    }
+    else {
+        printf("[ERR] Prefetch resolved %zu of 8 handles or returned wrong pointers\n", foundCount);
+    }
+    for (int i = 0; i < 8; i++) rma_free(allocator, chain[i]);
+
+    // ========================================
+    // Test 13: Per-Block Metadata Test
+    // ========================================
+    printf("\n=== Test 13: Per-Block Metadata ===\n");
+
+    struct rma_options_t const metaOptions = { .metaWidth = 4 };
+    struct rma_mem_header_t *tagged = rma_memHeaderInitEx(64 * 1024, 256, &metaOptions);
+    rma_handle_t typed[16];
+    for (int i = 0; i < 16; i++){
+        typed[i] = rma_alloc(tagged);
+        *(uint32_t*)rma_meta(tagged, typed[i]) = (uint32_t)(i % 4); // type id
+    }
+    rma_free(tagged, typed[5]);
+
+    // scan only the metadata for type id 1
+    uint32_t const *metaSlots = rma_metaTable(tagged);
+    int typeOneCount = 0, handlesMatch = 1;
+    for (size_t i = 0; i < tagged->numBlocks; i++){
+        if (metaSlots[i] != 1) continue;
+        typeOneCount++;
+        rma_handle_t const owner = rma_handleAt(tagged, i);
+        if (owner == RMA_INVALID_HANDLE || *(uint32_t*)rma_meta(tagged, owner) != 1) handlesMatch = 0;
+    }
+
+    if (typeOneCount == 3 && handlesMatch && rma_meta(tagged, typed[5]) == NULL && rma_meta(allocator, typed[0]) == NULL){
+        printf("[SUCCESS] Found %d blocks of type 1 by scanning metadata only\n", typeOneCount);
+    }
+    else {
+        printf("[ERR] Metadata scan found %d blocks of type 1 (expected 3)\n", typeOneCount);
+    }
+    rma_destroy(tagged);
+
+    // ========================================
+    // Test 14: TTL Expiry Test
+    // ========================================
+    printf("\n=== Test 14: TTL Expiry ===\n");
+
+    struct rma_options_t const ttlOptions = { .ttl = 1 };
+    struct rma_mem_header_t *expiring = rma_memHeaderInitEx(256 * 1024, 256, &ttlOptions);
+    rma_handle_t shortLived = rma_allocWithTTL(expiring, 10);
+    rma_handle_t distant = rma_allocWithTTL(expiring, 100000);
+    rma_handle_t renewed = rma_allocWithTTL(expiring, 10);
+    rma_handle_t permanent = rma_alloc(expiring);
+    rma_setTTL(expiring, renewed, 50);
+
+    size_t const firstSweep = rma_expire(expiring, 20, NULL, NULL);
+    int const afterFirst = !rma_getPtr(expiring, shortLived) && rma_getPtr(expiring, renewed) != NULL;
+    size_t const secondSweep = rma_expire(expiring, 200000, NULL, NULL);
+
+    // blocks the callback re-arms or cancels are not counted as expired
+    struct test_expiry_keep_t keep = { rma_allocWithTTL(expiring, 5), rma_allocWithTTL(expiring, 5) };
+    rma_handle_t const dropped = rma_allocWithTTL(expiring, 5);
+    size_t const callbackSweep = rma_expire(expiring, 200010, keepOnExpire, &keep);
+    int const keptByCallback = rma_getPtr(expiring, keep.rearmed) && rma_getPtr(expiring, keep.cancelled) && !rma_getPtr(expiring, dropped);
+
+    // a far timer is reached in one jump and expires exactly on its tick
+    rma_handle_t const far = rma_allocWithTTL(expiring, 10000000);
+    size_t const beforeFar = rma_expire(expiring, 10200009, NULL, NULL);
+    size_t const atFar = rma_expire(expiring, 10200010, NULL, NULL);
+
+    if (firstSweep == 1 && afterFirst && secondSweep == 2 && rma_getPtr(expiring, permanent) && !rma_getPtr(expiring, distant) &&
+        callbackSweep == 1 && keptByCallback && beforeFar == 1 && atFar == 1 && !rma_getPtr(expiring, far) && rma_getPtr(expiring, keep.cancelled)){
+        printf("[SUCCESS] Expired blocks on time, renewed, re-armed and permanent blocks kept\n");
+    }
+    else {
+        printf("[ERR] TTL expiry freed %zu, %zu, %zu, %zu then %zu blocks (expected 1, 2, 1, 1 then 1)\n",
+               firstSweep, secondSweep, callbackSweep, beforeFar, atFar);
+    }
+    rma_destroy(expiring);
+
+    // ========================================
+    // Test 15: CLOCK Eviction Test
+    // ========================================
+    printf("\n=== Test 15: CLOCK Eviction ===\n");
+
+    struct rma_options_t const cacheOptions = { .eviction = 1 };
+    struct rma_mem_header_t *cache = rma_memHeaderInitEx(16 * 1024, 256, &cacheOptions);
+    size_t const cacheCapacity = cache->numBlocks;
+    rma_handle_t hot = rma_allocOrEvict(cache, NULL, NULL);
+    rma_handle_t pinnedEntry = rma_allocOrEvict(cache, NULL, NULL);
+    rma_pin(cache, pinnedEntry);
+    while (cache->numAllocated < cacheCapacity) rma_allocOrEvict(cache, NULL, NULL);
+
+    // keep touching one entry while the cache churns through many more
+    int evictionsOk = 1;
+    for (size_t i = 0; i < 3 * cacheCapacity; i++){
+        rma_getPtr(cache, hot);
+        if (rma_allocOrEvict(cache, NULL, NULL) == RMA_INVALID_HANDLE) evictionsOk = 0;
+    }
+
+    if (evictionsOk && cache->numAllocated == cacheCapacity && rma_getPtr(cache, hot) && rma_getPtr(cache, pinnedEntry)){
+        printf("[SUCCESS] %zu evictions kept the hot and the pinned entry\n", 3 * cacheCapacity);
+    }
+    else {
+        printf("[ERR] Eviction lost the hot or pinned entry (allocations ok: %d)\n", evictionsOk);
+    }
+    rma_destroy(cache);
+
+    // ========================================
+    // Test 16: Blocking Allocation Test
+    // ========================================
+    printf("\n=== Test 16: Blocking Allocation ===\n");
+
+    struct rma_options_t const sharedOptions = { .threadSafe = 1 };
+    struct rma_mem_header_t *shared = rma_memHeaderInitEx(16 * 1024, 1024, &sharedOptions);
+    int const poolEvents = rma_eventFd(shared);
+    rma_handle_t lastBlock = RMA_INVALID_HANDLE;
+    while (shared->numAllocated < shared->numBlocks) lastBlock = rma_alloc(shared);
+
+    // a second thread frees a block while this one waits for it
+    struct test_delayed_free_t request = { shared, lastBlock };
+    pthread_t freer;
+    pthread_create(&freer, NULL, delayedFree, &request);
+    rma_handle_t const waited = rma_allocWait(shared, 5000);
+    pthread_join(freer, NULL);
+
+    uint64_t eventCount = 0;
+    ssize_t const eventBytes = read(poolEvents, &eventCount, sizeof(eventCount));
+    rma_handle_t const timedOut = rma_allocWait(shared, 20);
+
+    if (waited != RMA_INVALID_HANDLE && timedOut == RMA_INVALID_HANDLE && eventBytes == sizeof(eventCount) && eventCount == 1){
+        printf("[SUCCESS] Woke up for the freed block, eventfd signalled, full pool timed out\n");
+    }
+    else {
+        printf("[ERR] Blocking allocation failed (woke: %d, event: %d, timeout: %d)\n",
+               waited != RMA_INVALID_HANDLE, eventBytes == sizeof(eventCount), timedOut == RMA_INVALID_HANDLE);
+    }
+    rma_destroy(shared);
+
+    // ========================================
+    // Test 17: Cache Coloring Test
+    // ========================================
+    printf("\n=== Test 17: Cache Coloring ===\n");
+
+    struct rma_options_t const coloredOptions = { .coloring = 1 };
+    struct rma_mem_header_t *colored = rma_memHeaderInitEx(64 * 1024, 4096, &coloredOptions);
+    rma_handle_t const firstColored = rma_alloc(colored);
+    rma_handle_t const secondColored = rma_alloc(colored);
+    memset(rma_getPtr(colored, firstColored), 0xAB, 4096);
+    memset(rma_getPtr(colored, secondColored), 0xCD, 4096);
+    uintptr_t const colorDistance = (uintptr_t)rma_getPtr(colored, secondColored) - (uintptr_t)rma_getPtr(colored, firstColored);
+
+    // the padding must survive relocation and keep whole blocks intact
+    colored = rma_resize(colored, 128 * 1024);
+    unsigned char const *firstBytes = rma_getPtr(colored, firstColored);
+
+    if (colored->blockStride == 4096 + RMA_COLOR_STEP && colorDistance % 4096 == RMA_COLOR_STEP &&
+        firstBytes[0] == 0xAB && firstBytes[4095] == 0xAB && *(unsigned char*)rma_getPtr(colored, secondColored) == 0xCD){
+        printf("[SUCCESS] Consecutive blocks start %zu bytes apart, data intact after resize\n", (size_t)colorDistance);
+    }
+    else {
+        printf("[ERR] Cache coloring failed (stride: %zu, distance: %zu)\n", colored->blockStride, (size_t)colorDistance);
+    }
+    rma_destroy(colored);
+
+    // ========================================
+    // Test 18: Deduplication Test
+    // ========================================
+    printf("\n=== Test 18: Deduplication ===\n");
+
+    struct rma_options_t const dedupOptions = { .dedup = 1 };
+    struct rma_mem_header_t *deduped = rma_memHeaderInitEx(32 * 1024, 256, &dedupOptions);
+    rma_handle_t copies[3];
+    for (int i = 0; i < 3; i++){
+        copies[i] = rma_alloc(deduped);
+        memset(rma_getPtr(deduped, copies[i]), 'd', 256);
+    }
+    int const merges = rma_dedupBlock(deduped, copies[0]) * 100 + rma_dedupBlock(deduped, copies[1]) * 10 + rma_dedupBlock(deduped, copies[2]);
+    size_t const sharedBlocks = deduped->numAllocated;
+    int const sameBlock = rma_getPtr(deduped, copies[1]) == rma_getPtr(deduped, copies[0]);
+
+    // writing through one handle must not leak into the others
+    char *privateCopy = rma_getPtrMut(deduped, copies[1]);
+    privateCopy[0] = 'w';
+    int const isolated = *(char*)rma_getPtr(deduped, copies[0]) == 'd' && privateCopy[255] == 'd';
+
+    // the shared block survives its owner and a relocation
+    rma_free(deduped, copies[0]);
+    deduped = rma_resize(deduped, 64 * 1024);
+    char const *survivor = rma_getPtr(deduped, copies[2]);
+
+    if (merges == 11 && sharedBlocks == 1 && sameBlock && isolated && survivor && survivor[0] == 'd' && deduped->numAllocated == 2){
+        printf("[SUCCESS] 3 handles shared 1 block, copy-on-write isolated the writer, alias outlived its owner\n");
+    }
+    else {
+        printf("[ERR] Deduplication failed (merges: %03d, blocks: %zu, shared: %d, isolated: %d)\n", merges, sharedBlocks, sameBlock, isolated);
+    }
+    rma_destroy(deduped);
+
+    // ========================================
+    // Test 19: Introspection Server Test
+    // ========================================
+    printf("\n=== Test 19: Introspection Server ===\n");
+
+    struct rma_options_t const liveOptions = { .threadSafe = 1 };
+    struct rma_mem_header_t *live = rma_memHeaderInitEx(16 * 1024, 256, &liveOptions);
+    rma_handle_t liveHandles[8];
+    for (int i = 0; i < 8; i++) liveHandles[i] = rma_alloc(live);
+    for (int i = 0; i < 8; i += 2) rma_free(live, liveHandles[i]);
+
+    char socketPath[64];
+    snprintf(socketPath, sizeof(socketPath), "/tmp/rma-test-%d.sock", (int)getpid());
+    rma_registerPool(live, "live");
+
+    char snapshotDir[] = "/tmp/rma-snapshots-XXXXXX";
+    int const haveSnapshotDir = mkdtemp(snapshotDir) != NULL;
+
+    char statsReply[512] = "", compactReply[256] = "", fragReply[256] = "", snapshotReply[512] = "", chosenReply[256] = "";
+    int const served = haveSnapshotDir && rma_introspectStart(socketPath, snapshotDir)
+        && introspectQuery(socketPath, "stats live\n", statsReply, sizeof(statsReply))
+        && introspectQuery(socketPath, "compact live\n", compactReply, sizeof(compactReply))
+        && introspectQuery(socketPath, "frag live\n", fragReply, sizeof(fragReply))
+        && introspectQuery(socketPath, "snapshot live\n", snapshotReply, sizeof(snapshotReply))
+        && introspectQuery(socketPath, "snapshot live /tmp/elsewhere\n", chosenReply, sizeof(chosenReply));
+    rma_introspectStop();
+
+    // the snapshot lands in the configured directory, a client-chosen path is refused
+    char snapshotPath[256];
+    snprintf(snapshotPath, sizeof(snapshotPath), "%s/live.1.rma", snapshotDir);
+    FILE *snapshotFile = fopen(snapshotPath, "rb");
+    long snapshotSize = -1;
+    if (snapshotFile){
+        fseek(snapshotFile, 0, SEEK_END);
+        snapshotSize = ftell(snapshotFile);
+        fclose(snapshotFile);
+    }
+    int const snapshotted = strstr(snapshotReply, snapshotPath) && snapshotSize == (long)live->totalSize && strstr(chosenReply, "error ");
+    remove(snapshotPath);
+    if (haveSnapshotDir) rmdir(snapshotDir);
+
+    // a file at the socket path that isn't a socket is left alone
+    char occupiedPath[64];
+    snprintf(occupiedPath, sizeof(occupiedPath), "/tmp/rma-test-%d.file", (int)getpid());
+    FILE *occupied = fopen(occupiedPath, "w");
+    if (occupied) fclose(occupied);
+    int const occupiedKept = occupied && !rma_introspectStart(occupiedPath, NULL) && access(occupiedPath, F_OK) == 0;
+    remove(occupiedPath);
+
+    if (served && strstr(statsReply, "allocated=4 ") && strstr(compactReply, "moved=2") && strstr(fragReply, "runs=1 ") && snapshotted &&
+        occupiedKept){
+        printf("[SUCCESS] Stats, compaction and a snapshot served over %s, foreign files left alone\n", socketPath);
+    }
+    else {
+        printf("[ERR] Introspection failed (served: %d, snapshot: %d, occupied kept: %d, reply: %s)\n", served, snapshotted, occupiedKept, statsReply);
+    }
+    rma_destroy(live);
+
+    // ========================================
+    // Test 20: Shared-Memory Stats Page Test
+    // ========================================
+    printf("\n=== Test 20: Shared-Memory Stats Page ===\n");
+
+    struct rma_mem_header_t *published = rma_memHeaderInit(16 * 1024, 256);
+    int const publishedOk = rma_publishStats(published, "published");
+    for (int i = 0; i < 3; i++) rma_alloc(published);
+    rma_free(published, rma_alloc(published));
+
+    // every allocation entry point lands in the latency histogram
+    rma_allocSized(published, 100);
+    rma_allocValue(published, "longer than an inline value", 27);
+
+    // read it the way rma-top does: through a separate read-only mapping
+    char pagePath[128];
+    snprintf(pagePath, sizeof(pagePath), "%s/%s%d.published", RMA_STATS_PAGE_DIR, RMA_STATS_PAGE_PREFIX, (int)getpid());
+    struct rma_stats_page_t pageCopy = {0};
+    FILE *pageFile = fopen(pagePath, "rb");
+    if (pageFile){
+        void *mapping = mmap(NULL, sizeof(pageCopy), PROT_READ, MAP_SHARED, fileno(pageFile), 0);
+        if (mapping != MAP_FAILED){
+            rma_readStatsPage(mapping, &pageCopy);
+            munmap(mapping, sizeof(pageCopy));
+        }
+        fclose(pageFile);
+    }
+    rma_destroy(published);
+
+    uint64_t latencySamples = 0;
+    for (size_t bucket = 0; bucket < RMA_LATENCY_BUCKETS; bucket++) latencySamples += pageCopy.latency[bucket];
+
+    if (publishedOk && pageCopy.numAllocated == 5 && pageCopy.allocs == 6 && pageCopy.frees == 1 && latencySamples == 6 &&
+        access(pagePath, F_OK) != 0){
+        printf("[SUCCESS] Page showed 5 allocated blocks (6 claims, 6 latency samples, 1 release) and was removed with the pool\n");
+    }
+    else {
+        printf("[ERR] Stats page failed (published: %d, allocated: %llu, allocs: %llu, frees: %llu, latency samples: %llu)\n", publishedOk,
+               (unsigned long long)pageCopy.numAllocated, (unsigned long long)pageCopy.allocs, (unsigned long long)pageCopy.frees,
+               (unsigned long long)latencySamples);
+    }
+
+    // ========================================
+    // Test 21: Requested-Size Tracking Test
+    // ========================================
+    printf("\n=== Test 21: Requested-Size Tracking ===\n");
+
+    struct rma_options_t const sizedOptions = { .sizeTracking = 1 };
+    struct rma_mem_header_t *sized = rma_memHeaderInitEx(16 * 1024, 128, &sizedOptions);
+    rma_handle_t const small = rma_allocSized(sized, 20);
+    rma_handle_t const large = rma_allocSized(sized, 100);
+    rma_alloc(sized); // unsized, left out of the figures
+    rma_handle_t const oversized = rma_allocSized(sized, 129);
+
+    struct rma_stats_t sizeStats;
+    rma_getStats(sized, &sizeStats);
+    size_t const smallSize = rma_getSize(sized, small);
+    rma_free(sized, large);
+    size_t const freedSize = rma_getSize(sized, large);
+
+    if (oversized == RMA_INVALID_HANDLE && smallSize == 20 && freedSize == 0 && sizeStats.sizedBlocks == 2 &&
+        sizeStats.wastedBytes == 136 && sizeStats.sizeHistogram[4] == 1 && sizeStats.sizeHistogram[6] == 1){
+        printf("[SUCCESS] 120 of 256 sized bytes used, 136 bytes of internal fragmentation\n");
+    }
+    else {
+        printf("[ERR] Size tracking failed (sized: %zu, wasted: %zu, small: %zu)\n", sizeStats.sizedBlocks, sizeStats.wastedBytes, smallSize);
+    }
+    rma_destroy(sized);
+
+    // ========================================
+    // Test 22: Bitmap Heatmap Test
+    // ========================================
+    printf("\n=== Test 22: Bitmap Heatmap ===\n");
+
+    struct rma_mem_header_t *mapped = rma_memHeaderInit(rma_poolSizeForBlocks(64, 1024, NULL), 1024);
+    for (int i = 0; i < 18; i++) rma_alloc(mapped);
+
+    // 4 blocks per 4 KiB pixel: 4 full pixels, one half full, the rest empty
+    FILE *heatmapFile = tmpfile();
+    int const dumped = heatmapFile && rma_dumpHeatmap(mapped, fileno(heatmapFile));
+
+    rma_registerPool(mapped, "heatmap");
+    int const recording = heatmapFile && rma_heatmapStart("heatmap", fileno(heatmapFile), 20);
+    struct timespec const recordTime = { 0, 70 * 1000000 }; // 70 ms
+    nanosleep(&recordTime, NULL);
+    size_t const frames = rma_heatmapStop();
+
+    // the first frame starts with its text preamble, its 16 pixels follow the maxval line
+    unsigned char frame[256] = {0};
+    unsigned char const *pixels = NULL;
+    if (heatmapFile){
+        rewind(heatmapFile);
+        size_t const length = fread(frame, 1, sizeof(frame) - 1, heatmapFile);
+        char const *maxval = strstr((char const*)frame, "\n255\n");
+        if (maxval && (size_t)((unsigned char const*)maxval + 5 - frame) + 16 <= length) pixels = (unsigned char const*)maxval + 5;
+        fclose(heatmapFile);
+    }
+
+    // a recorder stuck writing to a full pipe must not hold the registry lock
+    int stalled[2] = { -1, -1 };
+    int registryFree = 0;
+    if (pipe(stalled) == 0){
+        char filler[4096] = {0};
+        fcntl(stalled[1], F_SETFL, O_NONBLOCK);
+        while (write(stalled[1], filler, sizeof(filler)) > 0);
+        fcntl(stalled[1], F_SETFL, 0);
+
+        if (rma_heatmapStart("heatmap", stalled[1], 10)){
+            nanosleep(&recordTime, NULL);
+            registryFree = rma_unregisterPool(mapped) && rma_registerPool(mapped, "heatmap");
+
+            // drain the pipe so the blocked frame completes and the recorder can stop
+            fcntl(stalled[0], F_SETFL, O_NONBLOCK);
+            while (read(stalled[0], filler, sizeof(filler)) > 0);
+            rma_heatmapStop();
+        }
+        close(stalled[0]);
+        close(stalled[1]);
+    }
+
+    if (dumped && recording && frames >= 2 && pixels && pixels[0] == 255 && pixels[3] == 255 && pixels[4] == 127 && pixels[5] == 0 && registryFree){
+        printf("[SUCCESS] 64 blocks drawn as 16 pixels, %zu periodic frames appended, registry usable while a write stalls\n", frames);
+    }
+    else {
+        printf("[ERR] Heatmap failed (dumped: %d, recording: %d, frames: %zu, pixels: %s, registry free: %d)\n", dumped, recording, frames,
+               pixels ? "ok" : "missing", registryFree);
+    }
+    rma_destroy(mapped);
+
+    // ========================================
+    // Test 23: In-Place Pool Test
+    // ========================================
+    printf("\n=== Test 23: In-Place Pool ===\n");
+
+    static _Alignas(64) unsigned char placeBuffer[16384];
+    struct rma_mem_header_t *misplaced = rma_initInPlace(placeBuffer + 1, sizeof(placeBuffer) - 1, 256, NULL);
+    struct rma_mem_header_t *placed = rma_initInPlace(placeBuffer, sizeof(placeBuffer), 256, NULL);
+
+    size_t placedBlocks = 0;
+    while (placed && rma_alloc(placed) != RMA_INVALID_HANDLE) placedBlocks++;
+
+    // the pool may not outgrow the buffer it was given
+    struct rma_mem_header_t *overgrown = placed ? rma_resize(placed, sizeof(placeBuffer) * 2) : NULL;
+    int const insideBuffer = (void*)placed == (void*)placeBuffer;
+
+    if (misplaced == NULL && placed && insideBuffer && overgrown == NULL && placedBlocks == placed->numBlocks && placedBlocks > 0){
+        printf("[SUCCESS] %zu blocks in a 16 KiB static buffer, growth refused\n", placedBlocks);
+    }
+    else {
+        printf("[ERR] In-place pool failed (blocks: %zu)\n", placedBlocks);
+    }
+    rma_destroy(placed); // leaves placeBuffer alone
+
+    // ========================================
+    // Test 24: Child Pool Test
+    // ========================================
+    printf("\n=== Test 24: Child Pool ===\n");
+
+    struct rma_mem_header_t *family = rma_memHeaderInit(rma_poolSizeForBlocks(32, 1024, NULL), 1024);
+    rma_handle_t const parentHandle = rma_alloc(family);
+    struct rma_mem_header_t *child = rma_createChild(family, 6 * 1024, 128);
+    size_t const runBlocks = family->numAllocated - 1;
+
+    rma_handle_t const childHandle = child ? rma_alloc(child) : RMA_INVALID_HANDLE;
+    int const crossFree = rma_free(family, childHandle);
+    int const crossGet = child && rma_getPtr(child, parentHandle) == NULL;
+    int const pinnedRun = rma_compact(family) == 0 && rma_resize(family, family->totalSize * 2) == NULL;
+    int const cloneRefused = rma_clone(family) == NULL;
+
+    // the run's own handle can't free it while the child lives
+    int const runFree = child ? rma_free(family, child->parentHandle) : 0;
+    int const runKept = family->numAllocated == runBlocks + 1;
+
+    // a grandchild's tag differs from every ancestor's
+    struct rma_mem_header_t *grandchild = child ? rma_createChild(child, 2 * 1024, 64) : NULL;
+    int const grandchildTag = grandchild && grandchild->poolTag != child->poolTag && grandchild->poolTag != family->poolTag;
+
+    // a parent with live children is left intact
+    rma_destroy(child);
+    int const parentKept = child && child->numChildren == 1 && rma_getPtr(child, childHandle) != NULL;
+    rma_destroy(grandchild);
+
+    rma_destroy(child);
+    size_t const afterDestroy = family->numAllocated;
+
+    // siblings never share a tag, the 15th child finds none left
+    struct rma_mem_header_t *siblings[RMA_INLINE_TAG];
+    size_t numSiblings = 0;
+    while (numSiblings < RMA_INLINE_TAG && (siblings[numSiblings] = rma_createChild(family, 512, 64)) != NULL) numSiblings++;
+    uint32_t siblingTags = 0;
+    for (size_t i = 0; i < numSiblings; i++){
+        siblingTags |= 1u << siblings[i]->poolTag;
+        rma_destroy(siblings[i]);
+    }
+
+    if (child && childHandle != RMA_INVALID_HANDLE && runBlocks == 7 && crossFree == -3 && crossGet && pinnedRun && cloneRefused &&
+        runFree == -3 && runKept && afterDestroy == 1 && grandchildTag && parentKept &&
+        numSiblings == RMA_INLINE_TAG - 1 && siblingTags == 0x7FFE && family->numAllocated == 1){
+        printf("[SUCCESS] Child carved from %zu parent blocks, cross-pool handles rejected, run returned, %zu distinct sibling tags\n",
+               runBlocks, numSiblings);
+    }
+    else {
+        printf("[ERR] Child pool failed (run: %zu, cross free: %d, clone refused: %d, run free: %d, after destroy: %zu, grandchild: %d, kept: %d, siblings: %zu)\n",
+               runBlocks, crossFree, cloneRefused, runFree, afterDestroy, grandchildTag, parentKept, numSiblings);
+    }
+    rma_destroy(family);
+
+    // ========================================
+    // Test 25: Warm Pool Cache Test
+    // ========================================
+    printf("\n=== Test 25: Warm Pool Cache ===\n");
+
+    // the cache is opt-in
+    size_t const defaultCap = rma_setPoolCacheLimit(1024 * 1024);
+
+    size_t const warmSize = rma_poolSizeForBlocks(16, 512, NULL);
+    struct rma_mem_header_t *cold = rma_memHeaderInit(warmSize, 512);
+    rma_alloc(cold);
+    rma_handle_t const coldHandle = rma_alloc(cold);
+    rma_destroy(cold); // parked, not freed
+
+    struct rma_mem_header_t *warm = rma_memHeaderInit(warmSize, 512);
+    int const reused = warm == cold && warm->numAllocated == 0 && rma_getPtr(warm, coldHandle) == NULL;
+    rma_handle_t const warmHandle = rma_alloc(warm);
+
+    // the handle counter carries on, so the reused pool doesn't repeat old handles
+    int const counterKept = (warmHandle & 0xFFF) == (coldHandle & 0xFFF) + 1;
+
+    // draining releases the parked pools, a zero cap keeps new ones out
+    rma_destroy(warm);
+    size_t const drained = rma_drainPoolCache();
+    rma_setPoolCacheLimit(defaultCap);
+
+    if (reused && counterKept && defaultCap == 0 && drained == 1 && rma_drainPoolCache() == 0){
+        printf("[SUCCESS] Destroyed pool reused warm with cleared metadata\n");
+    }
+    else {
+        printf("[ERR] Pool cache failed (reused: %d, counter kept: %d, default cap: %zu, drained: %zu)\n", reused, counterKept, defaultCap, drained);
+    }
+
+    // ========================================
+    // Test 26: Striped Block Locks Test
+    // ========================================
+    printf("\n=== Test 26: Striped Block Locks ===\n");
+
+    struct rma_options_t const lockOptions = { .lockStripes = 64 };
+    struct rma_mem_header_t *locked = rma_memHeaderInitEx(rma_poolSizeForBlocks(16, 256, &lockOptions), 256, &lockOptions);
+    struct test_locked_counter_t counter = { locked, rma_alloc(locked), 100000 };
+    *(unsigned long*)rma_getPtr(locked, counter.handle) = 0;
+
+    pthread_t incrementers[2];
+    for (int i = 0; i < 2; i++) pthread_create(&incrementers[i], NULL, lockedIncrements, &counter);
+    for (int i = 0; i < 2; i++) pthread_join(incrementers[i], NULL);
+
+    struct rma_stats_t lockStats;
+    rma_getStats(locked, &lockStats);
+    unsigned long const total = *(unsigned long*)rma_getPtr(locked, counter.handle);
+    int const unstriped = rma_lock(allocator, counter.handle) == 0 && rma_lock(locked, RMA_INVALID_HANDLE) == 0;
+
+    if (total == 200000 && lockStats.lockStripes == 64 && lockStats.lockAcquisitions == 200000 && unstriped){
+        printf("[SUCCESS] 200000 locked increments, %zu of them contended\n", lockStats.lockContended);
+    }
+    else {
+        printf("[ERR] Striped locks failed (total: %lu, acquisitions: %zu)\n", total, lockStats.lockAcquisitions);
+    }
+    rma_destroy(locked);
+
+    // ========================================
+    // Test 27: Inline Value Handles Test
+    // ========================================
+    printf("\n=== Test 27: Inline Value Handles ===\n");
+
+    size_t const allocatedBefore = allocator->numAllocated;
+    rma_handle_t value = rma_allocValue(allocator, "ok", 2);
+    char smallOut[8] = {0};
+    size_t const smallLength = rma_getValue(allocator, value, smallOut, sizeof(smallOut));
+    int const noBlock = rma_isInline(value) && allocator->numAllocated == allocatedBefore && rma_getPtr(allocator, value) == NULL;
+
+    // all three bytes round-trip, and there is no block to write through
+    rma_handle_t const full = rma_allocValue(allocator, "abc", 3);
+    char fullOut[4] = {0};
+    int const fullInline = rma_isInline(full) && rma_getValue(allocator, full, fullOut, sizeof(fullOut)) == 3 &&
+                           strcmp(fullOut, "abc") == 0 && rma_getPtrMut(allocator, full) == NULL;
+
+    // growing past RMA_INLINE_MAX moves the value into a block, which keeps the exact length
+    value = rma_setValue(allocator, value, "too long", 9);
+    char largeOut[16] = {0};
+    size_t const largeLength = rma_getValue(allocator, value, largeOut, sizeof(largeOut));
+    int const promoted = !rma_isInline(value) && allocator->numAllocated == allocatedBefore + 1 && strcmp(largeOut, "too long") == 0;
+
+    int const freed = rma_free(allocator, value) == 1 && rma_free(allocator, rma_allocValue(allocator, "x", 1)) == 1;
+
+    // overwriting a deduplicated value copies it first, the alias keeps the old bytes
+    struct rma_options_t const valueOptions = { .dedup = 1 };
+    struct rma_mem_header_t *values = rma_memHeaderInitEx(16 * 1024, 128, &valueOptions);
+    rma_handle_t const sharedValue = rma_allocValue(values, "shared value", 12);
+    rma_handle_t const alias = rma_allocValue(values, "shared value", 12);
+    int const merged = rma_dedupBlock(values, sharedValue) == 0 && rma_dedupBlock(values, alias) == 1;
+    char aliasOut[16] = {0};
+    char sharedOut[16] = {0};
+    int const copiedOnWrite = merged && rma_setValue(values, alias, "changed", 7) == alias && values->numAllocated == 2 &&
+                              rma_getValue(values, alias, aliasOut, sizeof(aliasOut)) == 7 && strcmp(aliasOut, "changed") == 0 &&
+                              rma_getValue(values, sharedValue, sharedOut, sizeof(sharedOut)) == 12 && strcmp(sharedOut, "shared value") == 0;
+    rma_destroy(values);
+
+    if (smallLength == 2 && memcmp(smallOut, "ok", 2) == 0 && noBlock && largeLength == 9 && promoted && freed && fullInline && copiedOnWrite){
+        printf("[SUCCESS] 2-byte value stored in the handle, promoted to a block at 9 bytes, shared value copied on write\n");
+    }
+    else {
+        printf("[ERR] Inline values failed (inline: %d, 3 bytes: %d, promoted: %d, length: %zu, freed: %d, copied: %d)\n",
+               noBlock, fullInline, promoted, largeLength, freed, copiedOnWrite);
+    }
+
     // ========================================
     // Final Memory State
     // ========================================
@@ -236,7 +1113,7 @@ int main(void){
     rma_displayMemInfo(allocator);
 
     // Cleanup
-    free(allocator);
+    rma_destroy(allocator);
     printf("\n[SUCCESS] All tests completed!\n");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,271 @@
+/**
+ * @file memConfig.c
+ * @brief Config-file and environment driven pool construction
+ * @author Robkoo
+ * @date 18.10.2026
+ * @version 0.0.3
+ * @since 0.0.3
+ *
+ * Parses the `key = value` config file format (also emitted by rma-tune)
+ * and the `RMA_*` environment variables into a struct rma_config_t. Every
+ * supported key is described once in a table, so adding a tunable means
+ * adding a single row.
+ */
+
+#include "memConfig.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief How a config value is parsed and stored
+ */
+enum rma_config_kind_t {
+    RMA_CONFIG_SIZE,    /**< size_t with optional K/M/G suffix */
+    RMA_CONFIG_FLAG,    /**< int, 0 or 1 (also accepts yes/no, true/false) */
+    RMA_CONFIG_BACKING  /**< int, "malloc" or "mmap" */
+};
+
+/**
+ * @brief Description of one supported config key
+ */
+struct rma_config_key_t {
+    char const *name;           /**< Key as written in the config file */
+    char const *envName;        /**< Suffix of the RMA_* environment variable */
+    enum rma_config_kind_t kind; /**< Value parser to use */
+    size_t offset;              /**< Offset of the destination in struct rma_config_t */
+};
+
+/**
+ * @brief Table of every key understood by the loader
+ */
+static struct rma_config_key_t const rma_configKeys[] = {
+    { "totalSize", "TOTAL_SIZE", RMA_CONFIG_SIZE,    offsetof(struct rma_config_t, totalSize) },
+    { "blockSize", "BLOCK_SIZE", RMA_CONFIG_SIZE,    offsetof(struct rma_config_t, blockSize) },
+    { "alignment", "ALIGNMENT",  RMA_CONFIG_SIZE,    offsetof(struct rma_config_t, options.alignment) },
+    { "backing",   "BACKING",    RMA_CONFIG_BACKING, offsetof(struct rma_config_t, options.backing) },
+    { "hugePages", "HUGE_PAGES", RMA_CONFIG_FLAG,    offsetof(struct rma_config_t, options.hugePages) },
+    { "epochTags", "EPOCH_TAGS", RMA_CONFIG_FLAG,    offsetof(struct rma_config_t, options.epochTags) },
+    { "metaWidth", "META_WIDTH", RMA_CONFIG_SIZE,    offsetof(struct rma_config_t, options.metaWidth) },
+    { "ttl",       "TTL",        RMA_CONFIG_FLAG,    offsetof(struct rma_config_t, options.ttl) },
+    { "eviction",  "EVICTION",   RMA_CONFIG_FLAG,    offsetof(struct rma_config_t, options.eviction) },
+    { "threadSafe", "THREAD_SAFE", RMA_CONFIG_FLAG,  offsetof(struct rma_config_t, options.threadSafe) },
+    { "coloring",  "COLORING",   RMA_CONFIG_FLAG,    offsetof(struct rma_config_t, options.coloring) },
+    { "dedup",     "DEDUP",      RMA_CONFIG_FLAG,    offsetof(struct rma_config_t, options.dedup) },
+    { "sizeTracking", "SIZE_TRACKING", RMA_CONFIG_FLAG, offsetof(struct rma_config_t, options.sizeTracking) },
+    { "lockStripes", "LOCK_STRIPES", RMA_CONFIG_SIZE, offsetof(struct rma_config_t, options.lockStripes) },
+};
+
+/**
+ * STATIC HELPER FUNCTIONS
+ */
+
+/**
+ * @brief Strip leading and trailing whitespace in place
+ * @param text String to trim (must not be NULL)
+ * @return Pointer to the first non-whitespace character
+ */
+static char* rma_configTrim(char *text){
+    while (isspace((unsigned char)*text)) text++;
+
+    size_t length = strlen(text);
+    while (length > 0 && isspace((unsigned char)text[length - 1])) text[--length] = '\0';
+
+    return text;
+}
+
+/**
+ * @brief Parse and store a single value according to its key description
+ * @param key Key description (must not be NULL)
+ * @param value Textual value (must not be NULL)
+ * @param config Destination configuration (must not be NULL)
+ * @return 1 on success, 0 if the value is malformed
+ */
+static int rma_configApply(struct rma_config_key_t const *key, char const *value, struct rma_config_t *config){
+    void *destination = (char*)config + key->offset;
+
+    switch (key->kind){
+        case RMA_CONFIG_SIZE: {
+            char *end = NULL;
+            errno = 0;
+            unsigned long long const size = strtoull(value, &end, 0);
+            if (end == value || errno == ERANGE) return 0;
+
+            // optional binary suffix, rejected when it would overflow instead of wrapping into a small size
+            unsigned shift = 0;
+            switch (toupper((unsigned char)*end)){
+                case 'G': shift += 10; // fall through
+                case 'M': shift += 10; // fall through
+                case 'K': shift += 10; end++; break;
+                default: break;
+            }
+            if (*end != '\0' || size > (SIZE_MAX >> shift)) return 0;
+
+            *(size_t*)destination = (size_t)size << shift;
+            return 1;
+        }
+        case RMA_CONFIG_FLAG: {
+            if (!strcmp(value, "1") || !strcmp(value, "yes") || !strcmp(value, "true")) *(int*)destination = 1;
+            else if (!strcmp(value, "0") || !strcmp(value, "no") || !strcmp(value, "false")) *(int*)destination = 0;
+            else return 0;
+            return 1;
+        }
+        case RMA_CONFIG_BACKING: {
+            if (!strcmp(value, "malloc")) *(int*)destination = RMA_BACKING_MALLOC;
+            else if (!strcmp(value, "mmap")) *(int*)destination = RMA_BACKING_MMAP;
+            else return 0;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Look up a key by its config file spelling
+ * @param name Key name (must not be NULL)
+ * @return Matching key description, or NULL if unknown
+ */
+static struct rma_config_key_t const* rma_configFindKey(char const *name){
+    for (size_t i = 0; i < sizeof(rma_configKeys) / sizeof(rma_configKeys[0]); i++){
+        if (!strcmp(rma_configKeys[i].name, name)) return &rma_configKeys[i];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Apply one config file (global keys first, then the pool's section)
+ * @param path Path of the config file (must not be NULL)
+ * @param name Pool name or NULL
+ * @param config Destination configuration (must not be NULL)
+ * @return 1 on success or missing file, 0 on a malformed value
+ *
+ * The file is read twice so that a `[name]` section overrides global keys
+ * regardless of where in the file it appears.
+ */
+static int rma_configLoadFile(char const *path, char const *name, struct rma_config_t *config){
+    FILE *file = fopen(path, "r");
+    if (file == NULL) return 1; // no config file, defaults and environment only
+
+    int ok = 1;
+    for (int pass = 0; pass < 2 && ok; pass++){
+        rewind(file);
+
+        char line[256];
+        size_t lineNumber = 0;
+        int inSection = 0; // 0 = global, 1 = our section, -1 = someone else's
+
+        while (fgets(line, sizeof(line), file)){
+            lineNumber++;
+
+            // drop comments and whitespace
+            char *comment = strchr(line, '#');
+            if (comment) *comment = '\0';
+            char *text = rma_configTrim(line);
+            if (*text == '\0') continue;
+
+            if (*text == '['){
+                char *close = strchr(text, ']');
+                if (close) *close = '\0';
+                inSection = (name != NULL && !strcmp(text + 1, name)) ? 1 : -1;
+                continue;
+            }
+
+            // pass 0 applies global keys, pass 1 the pool's own section
+            if ((pass == 0 && inSection != 0) || (pass == 1 && inSection != 1)) continue;
+
+            char *equals = strchr(text, '=');
+            if (equals == NULL){
+                fprintf(stderr, "RMA: %s:%zu: expected 'key = value'\n", path, lineNumber);
+                continue;
+            }
+            *equals = '\0';
+
+            char *keyName = rma_configTrim(text);
+            char *value = rma_configTrim(equals + 1);
+
+            struct rma_config_key_t const *key = rma_configFindKey(keyName);
+            if (key == NULL){
+                fprintf(stderr, "RMA: %s:%zu: unknown key '%s' ignored\n", path, lineNumber, keyName);
+                continue;
+            }
+
+            if (!rma_configApply(key, value, config)){
+                fprintf(stderr, "RMA: %s:%zu: invalid value '%s' for '%s'\n", path, lineNumber, value, keyName);
+                ok = 0;
+                break;
+            }
+        }
+    }
+
+    fclose(file);
+    return ok;
+}
+
+/**
+ * @brief Apply RMA_<KEY> or RMA_<NAME>_<KEY> environment variables
+ * @param name Pool name, or NULL for the global variables
+ * @param config Destination configuration (must not be NULL)
+ * @return 1 on success, 0 on a malformed value
+ */
+static int rma_configLoadEnv(char const *name, struct rma_config_t *config){
+    char prefix[96] = "RMA_";
+
+    if (name != NULL){
+        // pool names map to upper case with anything non-alphanumeric turned into '_'
+        size_t length = strlen(prefix);
+        for (char const *c = name; *c && length < sizeof(prefix) - 2; c++){
+            prefix[length++] = isalnum((unsigned char)*c) ? (char)toupper((unsigned char)*c) : '_';
+        }
+        prefix[length++] = '_';
+        prefix[length] = '\0';
+    }
+
+    for (size_t i = 0; i < sizeof(rma_configKeys) / sizeof(rma_configKeys[0]); i++){
+        char variable[160];
+        snprintf(variable, sizeof(variable), "%s%s", prefix, rma_configKeys[i].envName);
+
+        char const *value = getenv(variable);
+        if (value == NULL) continue;
+
+        if (!rma_configApply(&rma_configKeys[i], value, config)){
+            fprintf(stderr, "RMA: invalid value '%s' for %s\n", value, variable);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * FUNCTION DEFINITIONS
+ */
+
+int rma_loadConfig(char const *name, struct rma_config_t *config){
+    if (config == NULL) return 0;
+
+    memset(config, 0, sizeof(*config));
+    config->totalSize = RMA_DEFAULT_TOTAL_SIZE;
+    config->blockSize = RMA_DEFAULT_BLOCK_SIZE;
+
+    char const *path = getenv("RMA_CONFIG");
+    if (path == NULL) path = RMA_DEFAULT_CONFIG_PATH;
+
+    if (!rma_configLoadFile(path, name, config)) return 0;
+    if (!rma_configLoadEnv(NULL, config)) return 0;
+    if (name != NULL && !rma_configLoadEnv(name, config)) return 0;
+
+    return 1;
+}
+
+struct rma_mem_header_t* rma_createFromConfig(char const *name){
+    struct rma_config_t config;
+    if (!rma_loadConfig(name, &config)) return NULL;
+
+    return rma_memHeaderInitEx(config.totalSize, config.blockSize, &config.options);
+}
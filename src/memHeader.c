@@ -11,12 +11,241 @@
  * Handles bitmap tracking, offset calculations, and memory pool setup.
  */
 
+#define _GNU_SOURCE
+
 #include "memHeader.h"
+#include "memProbes.h"
+#include "memStatsPage.h"
 
+#include <fcntl.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <errno.h>
+#include <time.h>
+#include <sched.h>
+#include <linux/futex.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+/**
+ * @brief Size of the salt filter used by batched handle resolution
+ */
+#define RMA_SALT_FILTER_BITS 1024
+
+/**
+ * @brief Bits of the tick consumed by one timer wheel level
+ */
+#define RMA_TTL_SLOT_BITS 6
+
+/**
+ * @brief Marks a timer link that points at a wheel slot instead of a block
+ */
+#define RMA_TTL_HEAD_FLAG 0x80000000u
+
+/**
+ * @brief Highest fill of the dedup alias table, in percent of its capacity
+ */
+#define RMA_DEDUP_MAX_LOAD 75
+
+_Static_assert(RMA_TTL_WHEEL_SLOTS == 1 << RMA_TTL_SLOT_BITS, "RMA_TTL_SLOT_BITS must match RMA_TTL_WHEEL_SLOTS");
+
+/**
+ * @brief One logged allocation of an open transaction
+ */
+struct rma_tx_entry_t {
+    struct rma_mem_header_t *header; /**< Pool the block was allocated from */
+    rma_handle_t handle;             /**< Allocated handle (RMA_INVALID_HANDLE once freed) */
+};
+
+/**
+ * @brief Expiry entry of one block
+ *
+ * Links are block index + 1 so a zeroed entry means "no neighbour"; the
+ * first block of a slot has prev = RMA_TTL_HEAD_FLAG | slot.
+ */
+struct rma_ttl_entry_t {
+    uint64_t expiry;    /**< Tick at which the block is freed (0 = no expiry) */
+    uint32_t next;      /**< Next block in the same wheel slot */
+    uint32_t prev;      /**< Previous block, or the slot this block heads */
+};
+
+/**
+ * @brief Hierarchical timer wheel stored in the pool
+ */
+struct rma_timer_wheel_t {
+    uint64_t occupied[RMA_TTL_WHEEL_LEVELS];                      /**< Bit per non-empty slot, per level */
+    uint32_t heads[RMA_TTL_WHEEL_LEVELS * RMA_TTL_WHEEL_SLOTS];   /**< First block (index + 1) of every slot */
+};
+
+/**
+ * @brief One stripe of the rma_lock() table
+ *
+ * Padded to a cache line so threads locking different stripes don't
+ * share one.
+ */
+struct rma_lock_stripe_t {
+    uint32_t word;          /**< Futex lock word (0 free, 1 locked, 2 contended) */
+    uint32_t reserved;      /**< Keeps the counters 8-byte aligned */
+    size_t acquisitions;    /**< Locks taken on this stripe */
+    size_t contended;       /**< Locks that found the stripe held */
+    unsigned char padding[64 - 2 * sizeof(uint32_t) - 2 * sizeof(size_t)]; /**< Fills the cache line */
+};
+
+/**
+ * @brief Deduplication state of one block
+ */
+struct rma_dedup_block_t {
+    uint64_t hash;          /**< Content hash the block is indexed under (0 = not indexed) */
+    uint32_t shares;        /**< Alias handles resolving to this block besides its own */
+    uint32_t reserved;      /**< Padding, keeps entries 8 byte aligned */
+};
+
+/**
+ * @brief Content index entry, open addressing keyed by hash
+ */
+struct rma_dedup_entry_t {
+    uint64_t hash;          /**< Content hash of the block */
+    rma_handle_t owner;     /**< Handle owning the block (0 = empty slot) */
+    uint32_t reserved;      /**< Padding, keeps entries 8 byte aligned */
+};
+
+/**
+ * @brief Handle whose block was merged into another one
+ */
+struct rma_dedup_alias_t {
+    rma_handle_t alias;     /**< Handle given to the caller (0 = empty slot) */
+    rma_handle_t owner;     /**< Handle owning the shared block */
+};
+
+/**
+ * @brief Pool lock held by rma_poolLock(), released by rma_poolUnlock()
+ */
+struct rma_pool_guard_t {
+    struct rma_mem_header_t *header;   /**< Locked pool (NULL if nothing was locked) */
+    struct rma_mem_header_t *previous; /**< Pool this thread held before, restored on unlock */
+};
+
+/**
+ * @brief Allocation run by rma_allocTimed() with the pool lock held
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param guard Guard of the held lock, a step that waits drops and retakes it through here
+ * @param context Arguments of the public entry point
+ * @return Handle to the allocated block, or RMA_INVALID_HANDLE on failure
+ */
+typedef rma_handle_t (*rma_alloc_step_t)(struct rma_mem_header_t *header, struct rma_pool_guard_t *guard, void const *context);
+
+/**
+ * @brief Arguments of rma_allocValue() passed to its allocation step
+ */
+struct rma_value_args_t {
+    void const *value;      /**< Bytes to store */
+    size_t length;          /**< Number of bytes */
+};
+
+/**
+ * @brief Arguments of rma_allocWait() passed to its allocation step
+ */
+struct rma_wait_args_t {
+    int timeoutMs;              /**< Timeout in ms (negative = forever, 0 = don't wait) */
+    struct timespec deadline;   /**< CLOCK_MONOTONIC time the wait ends at (timeoutMs > 0) */
+};
+
+/**
+ * @brief Arguments of rma_allocOrEvict() passed to its allocation step
+ */
+struct rma_evict_args_t {
+    rma_block_callback_t onEvict;   /**< Optional callback run for the victim */
+    void *context;                  /**< User pointer passed to onEvict */
+};
+
+/**
+ * @brief Contiguous run of allocated blocks copied by rma_clone()
+ */
+struct rma_block_run_t {
+    size_t first;   /**< Index of the first block in the run */
+    size_t count;   /**< Number of blocks in the run */
+};
+
+/**
+ * @brief Work item of one rma_clone() copy thread
+ */
+struct rma_clone_job_t {
+    char const *source;                 /**< Data section of the source pool */
+    char *destination;                  /**< Data section of the clone */
+    size_t blockStride;                 /**< Distance between block starts in bytes */
+    struct rma_block_run_t const *runs; /**< Runs assigned to this job */
+    size_t numRuns;                     /**< Number of runs */
+};
+
+/**
+ * @brief Per-thread transaction log
+ *
+ * Entries of nested transactions are stored back to back; marks[] holds
+ * the log position at which each open transaction started.
+ */
+struct rma_tx_log_t {
+    struct rma_tx_entry_t *entries;  /**< Logged allocations (grown on demand) */
+    size_t count;                    /**< Number of used entries */
+    size_t capacity;                 /**< Number of allocated entries */
+    size_t marks[RMA_TX_MAX_DEPTH];  /**< Start position of every open transaction */
+    unsigned depth;                  /**< Number of open transactions */
+};
+
+static _Thread_local struct rma_tx_log_t rma_txLog;
+
+/**
+ * @brief Pool whose lock the calling thread holds, so callbacks can re-enter it
+ */
+static _Thread_local struct rma_mem_header_t *rma_heldPool;
+
+/**
+ * @brief Handle prefetched by the last rma_getPtrPrefetchNext() call of this thread
+ *
+ * Lets the following call skip resolving it again. The entry is only a
+ * hint and is re-validated before use, so frees and compaction in between
+ * are harmless.
+ */
+static _Thread_local struct {
+    struct rma_mem_header_t *header; /**< Pool the handle belongs to */
+    rma_handle_t handle;             /**< Prefetched handle */
+    size_t blockIndex;               /**< Block the handle resolved to */
+} rma_prefetchNextCache;
+
+/**
+ * @brief Process-wide list of pools made visible by rma_registerPool()
+ *
+ * The lock is held for the whole of an rma_forEachPool() visit, and by
+ * rma_destroy()/rma_resize()/rma_shrinkToFit() on registered pools, so a
+ * visitor never sees a pool disappear or move underneath it.
+ */
+static struct {
+    pthread_mutex_t lock;    /**< Protects the entries */
+    size_t count;            /**< Number of used entries */
+    struct {
+        struct rma_mem_header_t *header; /**< Registered pool */
+        char name[RMA_POOL_NAME_MAX];    /**< Name given at registration */
+    } entries[RMA_REGISTRY_MAX];
+} rma_registry = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+/**
+ * @brief Process-wide cache of destroyed pools waiting to be reused
+ *
+ * Parked pools have cleared metadata, so rma_memHeaderInitEx() only has to
+ * rewrite the header of one it takes. The cap starts at 0, which keeps the
+ * cache off until rma_setPoolCacheLimit() raises it.
+ */
+static struct {
+    pthread_mutex_t lock;    /**< Protects the cache */
+    size_t maxBytes;         /**< Cap set by rma_setPoolCacheLimit() */
+    size_t cachedBytes;      /**< Backing bytes held by parked pools */
+    size_t count;            /**< Number of parked pools */
+    struct rma_mem_header_t *pools[RMA_POOL_CACHE_MAX]; /**< Parked pools */
+} rma_poolCache = { .lock = PTHREAD_MUTEX_INITIALIZER };
 
 /**
  * STATIC HELPER FUNCTIONS
@@ -34,13 +263,25 @@ static uint32_t* rma_getBitmap(struct rma_mem_header_t *header){
     return (uint32_t*)((char*)header + header->bitmapOffset);
 }
 
+/**
+ * @brief Get pointer to the pinned-block bitmap
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @return Pointer to the pinned bitmap (same layout as the allocation bitmap)
+ *
+ * A set bit marks a block that rma_compact() must not move.
+ */
+static uint32_t* rma_getPinnedBitmap(struct rma_mem_header_t *header){
+    return (uint32_t*)((char*)header + header->pinnedBitmapOffset);
+}
+
 /**
  * @brief Get pointer to handle table array for handle-to-block mapping
  * @param header Pointer to RMA header structure (must not be NULL)
- * @return Pointer to handle table array as uint32_t* for salt storage
+ * @return Pointer to handle table array as uint32_t* for handle storage
  * 
  * Converts the stored handle table offset into a usable pointer. Each entry
- * in the table stores the salt value for the corresponding block index.
+ * in the table stores the full handle of the corresponding block index
+ * (0 for free blocks).
  */
 static uint32_t* rma_getHandleTable(struct rma_mem_header_t *header){
     return (uint32_t*)((char*)header + header->handleTableOffset);
@@ -60,7 +301,7 @@ static int rma_isBlockAllocated(uint32_t *bitmap, size_t blockIndex){
     size_t const arrayIndex = blockIndex / 32;
     size_t const bitIndex = blockIndex % 32;
 
-    return (int)(bitmap[arrayIndex] & (1 << bitIndex)) != 0;
+    return (bitmap[arrayIndex] & (1u << bitIndex)) != 0;
 }
 
 /**
@@ -76,8 +317,8 @@ static void rma_markBlockAllocated(uint32_t *bitmap, size_t blockIndex){
     size_t const arrayIndex = blockIndex / 32;
     size_t const bitIndex = blockIndex % 32;
 
-    // set the bit to 1 to indicate the block is allocated
-    bitmap[arrayIndex] |= (1 << bitIndex);
+    // set the bit to 1 to indicate the block is allocated (one store, rma_getStats() reads without the lock)
+    __atomic_store_n(&bitmap[arrayIndex], bitmap[arrayIndex] | (1u << bitIndex), __ATOMIC_RELAXED);
 }
 
 /**
@@ -94,7 +335,151 @@ static void rma_markBlockFree(uint32_t *bitmap, size_t blockIndex){
     size_t const bitIndex = blockIndex % 32;
 
     // set the bit to 0 to indicate the block is free
-    bitmap[arrayIndex] &= ~(1 << bitIndex);
+    __atomic_store_n(&bitmap[arrayIndex], bitmap[arrayIndex] & ~(1u << bitIndex), __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Update a statistics counter
+ * @param counter Counter in the pool header (must not be NULL)
+ * @param delta Signed change
+ *
+ * Callers hold the pool lock, so a plain read-modify-write is enough; the
+ * single atomic store lets rma_getStats() read the counter without it.
+ */
+static void rma_statAdd(size_t *counter, ptrdiff_t delta){
+    __atomic_store_n(counter, *counter + (size_t)delta, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Current monotonic time in nanoseconds
+ */
+static uint64_t rma_monotonicNs(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Mirror the pool counters into its stats page
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param allocs Blocks claimed since the last update
+ * @param frees Blocks released since the last update
+ * @param rescan Nonzero to recount the free runs now instead of every RMA_STATS_PAGE_SCAN_PERIOD updates
+ *
+ * Seqlock writer, called by the pool lock holder. Every field is written
+ * with a single atomic store so readers in other processes never see a
+ * torn value, only a sequence change that makes them retry.
+ */
+static void rma_statsPageUpdate(struct rma_mem_header_t *header, uint64_t allocs, uint64_t frees, int rescan){
+    struct rma_stats_page_t *page = header->statsPage;
+    if (page == NULL) return;
+
+    struct rma_stats_t stats;
+    int const scan = rescan || page->updates + 1 >= RMA_STATS_PAGE_SCAN_PERIOD;
+    if (scan) rma_getStats(header, &stats);
+
+    uint64_t const sequence = page->sequence;
+    __atomic_store_n(&page->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    __atomic_store_n(&page->totalSize, header->totalSize, __ATOMIC_RELAXED);
+    __atomic_store_n(&page->blockSize, header->blockSize, __ATOMIC_RELAXED);
+    __atomic_store_n(&page->numBlocks, header->numBlocks, __ATOMIC_RELAXED);
+    __atomic_store_n(&page->numAllocated, header->numAllocated, __ATOMIC_RELAXED);
+    __atomic_store_n(&page->allocs, page->allocs + allocs, __ATOMIC_RELAXED);
+    __atomic_store_n(&page->frees, page->frees + frees, __ATOMIC_RELAXED);
+    if (scan){
+        __atomic_store_n(&page->freeRuns, stats.freeRuns, __ATOMIC_RELAXED);
+        __atomic_store_n(&page->largestFreeRun, stats.largestFreeRun, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&page->updates, scan ? 0 : page->updates + 1, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&page->sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Add one allocation latency sample to the stats page
+ * @param header Pointer to RMA header structure (must not be NULL, pool lock held)
+ * @param start rma_monotonicNs() taken before the pool lock, 0 if it was not taken
+ *
+ * Runs under the pool lock so rma_unpublishStats() cannot unmap the page
+ * between the lookup and the increment.
+ */
+static void rma_statsPageLatency(struct rma_mem_header_t *header, uint64_t start){
+    struct rma_stats_page_t *page = header->statsPage;
+    if (page == NULL || start == 0) return;
+
+    uint64_t const elapsed = rma_monotonicNs() - start;
+    size_t bucket = elapsed ? (size_t)(63 - __builtin_clzll(elapsed)) : 0;
+    if (bucket >= RMA_LATENCY_BUCKETS) bucket = RMA_LATENCY_BUCKETS - 1;
+    __atomic_fetch_add(&page->latency[bucket], 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Build the stats page path of a pool
+ * @param pid Process owning the pool
+ * @param name Pool name as stored in the page (must not be NULL)
+ * @param path Output buffer
+ * @param size Size of the output buffer
+ */
+static void rma_statsPagePath(int pid, char const *name, char *path, size_t size){
+    snprintf(path, size, "%s/%s%d.%s", RMA_STATS_PAGE_DIR, RMA_STATS_PAGE_PREFIX, pid, name);
+}
+
+/**
+ * @brief Get pointer to the per-block deduplication state
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @return Pointer to the array, or NULL if the pool was created without dedup
+ */
+static struct rma_dedup_block_t* rma_getDedupBlocks(struct rma_mem_header_t *header){
+    if (header->dedupBlocksOffset == 0) return NULL;
+    return (struct rma_dedup_block_t*)((char*)header + header->dedupBlocksOffset);
+}
+
+/**
+ * @brief Get pointer to the content index (dedupCapacity entries)
+ * @param header Pointer to RMA header structure with dedup (must not be NULL)
+ */
+static struct rma_dedup_entry_t* rma_getDedupIndex(struct rma_mem_header_t *header){
+    return (struct rma_dedup_entry_t*)((char*)header + header->dedupIndexOffset);
+}
+
+/**
+ * @brief Get pointer to the alias table (dedupCapacity entries)
+ * @param header Pointer to RMA header structure with dedup (must not be NULL)
+ */
+static struct rma_dedup_alias_t* rma_getDedupAliases(struct rma_mem_header_t *header){
+    return (struct rma_dedup_alias_t*)((char*)header + header->dedupAliasOffset);
+}
+
+/**
+ * @brief Final avalanche of a 64 bit hash (MurmurHash3 fmix64)
+ */
+static uint64_t rma_dedupMix(uint64_t value){
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+/**
+ * @brief Find the alias table slot of a handle
+ * @param header Pointer to RMA header structure with dedup (must not be NULL)
+ * @param alias Handle to look up
+ * @return Slot index, or SIZE_MAX if the handle is not an alias
+ */
+static size_t rma_dedupFindAlias(struct rma_mem_header_t *header, rma_handle_t alias){
+    struct rma_dedup_alias_t const *aliases = rma_getDedupAliases(header);
+    size_t const mask = header->dedupCapacity - 1;
+
+    for (size_t slot = rma_dedupMix(alias) & mask, probes = 0; probes <= mask; slot = (slot + 1) & mask, probes++){
+        if (aliases[slot].alias == alias) return slot;
+        if (aliases[slot].alias == 0) break;
+    }
+
+    return SIZE_MAX;
 }
 
 /**
@@ -117,23 +502,29 @@ static uint16_t rma_generateSalt(struct rma_mem_header_t *header){
     do {
         // get the first 16 bits of the random number as the salt
         uint16_t const salt = rand() & 0xFFFF;
-        // always zerofy the collision var
-        collision = 0;
+        // always zerofy the collision var (0 is the failure value, treat it as a collision)
+        collision = salt == 0;
 
         // get data structures
         uint32_t *bitmap = rma_getBitmap(header);
         uint32_t const *handleTable = rma_getHandleTable(header);
 
         // loop through all the allocated blocks
-        for (size_t blockIndex = 0; blockIndex < header->numBlocks; blockIndex++){
+        for (size_t blockIndex = 0; blockIndex < header->numBlocks && !collision; blockIndex++){
             if (rma_isBlockAllocated(bitmap, blockIndex)){
                 // if the generated salt is found, we found a collision
-                if (handleTable[blockIndex] == salt){
+                if ((handleTable[blockIndex] >> 16) == salt){
                     collision = 1; 
                     break; // stop checking, try new salt
                 }
             }
         }
+
+        // handles merged by rma_dedupBlock() no longer own a block but are still live
+        struct rma_dedup_alias_t const *aliases = header->numAliases ? rma_getDedupAliases(header) : NULL;
+        for (size_t slot = 0; aliases && slot < header->dedupCapacity && !collision; slot++){
+            collision = aliases[slot].alias != 0 && (aliases[slot].alias >> 16) == salt;
+        }
         
         if (!collision){
             // no collision found, this salt is unique
@@ -147,19 +538,62 @@ static uint16_t rma_generateSalt(struct rma_mem_header_t *header){
     return 0; // failed to generate salt
 }
 
+/**
+ * @brief Extract the pool tag from a handle
+ * @param handle Handle issued by any pool
+ * @return Tag in bits 15..12 of the handle (see RMA_HANDLE_TAG_SHIFT)
+ */
+static uint32_t rma_handleTag(rma_handle_t handle){
+    return (handle >> RMA_HANDLE_TAG_SHIFT) & (RMA_HANDLE_TAGS - 1);
+}
+
+/**
+ * @brief Bit position of each value byte inside an inline handle
+ *
+ * The first two bytes take the salt bits, the third the low counter bits.
+ */
+static unsigned const rma_inlineShifts[RMA_INLINE_MAX] = { 16, 24, 0 };
+
+/**
+ * @brief Pack a small value into an inline handle
+ * @param value Value bytes (may be NULL when length is 0)
+ * @param length Value length, at most RMA_INLINE_MAX
+ * @return Inline handle carrying the value
+ */
+static rma_handle_t rma_encodeInline(void const *value, size_t length){
+    uint32_t bits = 0;
+    for (size_t i = 0; i < length; i++) bits |= (uint32_t)((unsigned char const*)value)[i] << rma_inlineShifts[i];
+
+    return ((uint32_t)RMA_INLINE_TAG << RMA_HANDLE_TAG_SHIFT) | ((uint32_t)length << 8) | bits;
+}
+
+/**
+ * @brief Unpack the value of an inline handle
+ * @param handle Inline handle
+ * @param out Buffer of at least RMA_INLINE_MAX bytes
+ * @return Value length in bytes
+ */
+static size_t rma_decodeInline(rma_handle_t handle, unsigned char *out){
+    size_t const length = (handle >> 8) & 3;
+    for (size_t i = 0; i < length; i++) out[i] = (unsigned char)(handle >> rma_inlineShifts[i]);
+
+    return length;
+}
+
 /**
  * @brief Find the block index corresponding to a given handle
  * @param header Pointer to RMA header structure (must not be NULL)
  * @param handle Handle to search for in the handle table
  * @return Block index if found, SIZE_MAX if not found
  * 
- * Extracts the salt from the handle and searches through allocated blocks
- * to find the matching salt in the handle table. Only searches blocks
- * that are currently marked as allocated in the bitmap.
+ * Searches through allocated blocks for the exact handle in the handle
+ * table. Only searches blocks that are currently marked as allocated in
+ * the bitmap. Handles merged by rma_dedupBlock() are then looked up in
+ * the alias table and resolve to their owner's block. Handles carrying
+ * another pool's tag are rejected without scanning.
  */
 static size_t rma_findBlockByHandle(struct rma_mem_header_t *header, rma_handle_t handle){
-    // extract the upper 16 bits of the handle, which contain the unique salt
-    uint16_t const handleSalt = (uint16_t)(handle >> 16);
+    if (rma_handleTag(handle) != header->poolTag) return SIZE_MAX;
 
     // get data structures
     uint32_t *bitmap = rma_getBitmap(header);
@@ -168,17 +602,84 @@ static size_t rma_findBlockByHandle(struct rma_mem_header_t *header, rma_handle_
     // loop through all allocated blocks and attempt to locate the block with the provided handle
     for (size_t blockIndex = 0; blockIndex < header->numBlocks; blockIndex++){
         if (rma_isBlockAllocated(bitmap, blockIndex)){
-            if (handleTable[blockIndex] == handleSalt){
+            if (handleTable[blockIndex] == handle){
                 // found
                 return blockIndex;
             }
         }
     }
 
+    // a deduplicated handle resolves to the block of its owner
+    if (header->numAliases > 0 && handle != RMA_INVALID_HANDLE){
+        size_t const slot = rma_dedupFindAlias(header, handle);
+        if (slot != SIZE_MAX) return rma_findBlockByHandle(header, rma_getDedupAliases(header)[slot].owner);
+    }
+
     // not found
     return SIZE_MAX;
 }
 
+/**
+ * @brief Resolve several handles with a single pass over the handle table
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param salts Salts to look for, sorted ascending (must not be NULL)
+ * @param count Number of salts
+ * @param indices Output: block index per salt, SIZE_MAX if not found
+ * @return Number of salts found
+ *
+ * Salts are unique among allocated blocks, so the pass stops once every
+ * salt has been found. A small bit filter over the low salt bits rejects
+ * most blocks before the binary search.
+ */
+static size_t rma_findBlocksBySalts(struct rma_mem_header_t *header, uint16_t const *salts, size_t count, size_t *indices){
+    uint32_t *bitmap = rma_getBitmap(header);
+    uint32_t const *handleTable = rma_getHandleTable(header);
+    size_t found = 0;
+
+    uint32_t filter[RMA_SALT_FILTER_BITS / 32] = {0};
+    for (size_t i = 0; i < count; i++){
+        indices[i] = SIZE_MAX;
+        uint32_t const bit = salts[i] % RMA_SALT_FILTER_BITS;
+        filter[bit / 32] |= 1u << (bit % 32);
+    }
+
+    for (size_t blockIndex = 0; blockIndex < header->numBlocks && found < count; blockIndex++){
+        uint32_t const salt = handleTable[blockIndex] >> 16;
+        uint32_t const bit = salt % RMA_SALT_FILTER_BITS;
+        if (!(filter[bit / 32] & (1u << (bit % 32)))) continue;
+        if (!rma_isBlockAllocated(bitmap, blockIndex)) continue;
+
+        // binary search among the wanted salts
+        size_t low = 0, high = count;
+        while (low < high){
+            size_t const middle = low + (high - low) / 2;
+            if (salts[middle] < salt) low = middle + 1;
+            else high = middle;
+        }
+
+        // duplicates in the batch resolve to the same block
+        for (; low < count && salts[low] == salt; low++){
+            indices[low] = blockIndex;
+            found++;
+        }
+    }
+
+    return found;
+}
+
+/**
+ * @brief Check that a handle still resolves to a given block
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param handle Handle to check
+ * @param blockIndex Block index the handle is expected at
+ * @return 1 if the block is allocated and carries the handle's salt, 0 otherwise
+ */
+static int rma_isResolvedTo(struct rma_mem_header_t *header, rma_handle_t handle, size_t blockIndex){
+    if (blockIndex >= header->numBlocks) return 0;
+    if (!rma_isBlockAllocated(rma_getBitmap(header), blockIndex)) return 0;
+    return rma_getHandleTable(header)[blockIndex] == handle;
+}
+
 /**
  * @brief Validate a handle for correctness and current allocation status
  * @param header Pointer to RMA header structure (must not be NULL)
@@ -195,6 +696,8 @@ static size_t rma_findBlockByHandle(struct rma_mem_header_t *header, rma_handle_
  * 
  * - -2: Block exists but is not marked as allocated
  * 
+ * - -3: Handle carries another pool's tag
+ * 
  * Performs comprehensive validation including handle format checking,
  * existence verification, and allocation status confirmation.
  */
@@ -204,6 +707,12 @@ static int rma_isValidHandle(struct rma_mem_header_t *header, rma_handle_t handl
         return 0; // Provided handle is invalid
     }
 
+    // inline values have no handle table entry
+    if (rma_isInline(handle)) return -1;
+
+    // a handle from a parent or child pool is caught before the scan
+    if (rma_handleTag(handle) != header->poolTag) return -3;
+
     // Attempt to find the block for this handle
     size_t const blockIndex = rma_findBlockByHandle(header, handle);
     if (blockIndex == SIZE_MAX) return -1; // Block doesn't exist for handle
@@ -226,150 +735,3085 @@ static int rma_isValidHandle(struct rma_mem_header_t *header, rma_handle_t handl
  * points to a region of blockSize bytes.
  */
 static void* rma_getBlockPtr(struct rma_mem_header_t *header, size_t blockIndex){
-    return (char*)header + header->dataOffset + (blockIndex * header->blockSize);
+    return (char*)header + header->dataOffset + (blockIndex * header->blockStride);
 }
 
 /**
- * FUNCTION DEFINITIONS
+ * @brief Number of distinct cache-line offsets block starts cycle through
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @return Block starts per RMA_COLOR_PERIOD bytes that land on different cache sets
+ *
+ * A stride that is a multiple of RMA_COLOR_PERIOD puts every block at the
+ * same offset (1 color); a colored stride walks through all of them.
  */
+static size_t rma_blockColors(struct rma_mem_header_t const *header){
+    size_t a = header->blockStride, b = RMA_COLOR_PERIOD;
+    while (b != 0){
+        size_t const t = a % b;
+        a = b;
+        b = t;
+    }
 
-void* rma_memHeaderInit(size_t totalSize, size_t blockSize){
-    // Allocate the desired memory pool
-    void *memPool = malloc(totalSize);
-    if (memPool == NULL) return NULL;
+    // strides that are not a multiple of a cache line still only have one start per line
+    size_t const colors = RMA_COLOR_PERIOD / a;
+    return colors < RMA_COLOR_PERIOD / RMA_COLOR_STEP ? colors : RMA_COLOR_PERIOD / RMA_COLOR_STEP;
+}
 
-    // initialize the header at the start of the pool
-    struct rma_mem_header_t *header = (struct rma_mem_header_t*)memPool;
+/**
+ * @brief Get pointer to the epoch tag array
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @return Pointer to the tag array, or NULL if the pool has no epoch tags
+ */
+static uint32_t* rma_getEpochTable(struct rma_mem_header_t *header){
+    if (header->epochTableOffset == 0) return NULL;
+    return (uint32_t*)((char*)header + header->epochTableOffset);
+}
 
-    // Aproximate block sizing
-    size_t const headerSize = sizeof(struct rma_mem_header_t);
-    size_t const maxPossibleBlocks = (totalSize - headerSize) / blockSize;
+/**
+ * @brief Get pointer to the requested-size array
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @return Pointer to the size array, or NULL if the pool doesn't track sizes
+ */
+static uint32_t* rma_getSizeTable(struct rma_mem_header_t *header){
+    if (header->sizeTableOffset == 0) return NULL;
+    return (uint32_t*)((char*)header + header->sizeTableOffset);
+}
 
-    // Calculate layout offsets
-    size_t const bitmapSize = (maxPossibleBlocks + 31) / 32 * sizeof(uint32_t);
-    size_t const handleTableSize = maxPossibleBlocks * sizeof(uint32_t);
+/**
+ * @brief Get pointer to the user metadata array
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @return Pointer to the metadata array, or NULL if the pool has no metadata
+ */
+static unsigned char* rma_getMetaTable(struct rma_mem_header_t *header){
+    if (header->metaTableOffset == 0) return NULL;
+    return (unsigned char*)header + header->metaTableOffset;
+}
 
-    // initialize info of the struct
-    header->totalSize = totalSize;
-    header->usedSize = headerSize;
-    header->blockSize = blockSize;
-    header->numAllocated = 0;
-    header->nextHandle = 1; // Handles start at 1 (0 = invalid)
+/**
+ * @brief Get pointer to the per-block expiry entries
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @return Pointer to the entries, or NULL if the pool has no TTL support
+ */
+static struct rma_ttl_entry_t* rma_getTtlTable(struct rma_mem_header_t *header){
+    if (header->ttlTableOffset == 0) return NULL;
+    return (struct rma_ttl_entry_t*)((char*)header + header->ttlTableOffset);
+}
 
-    // Initialize offsets
-    header->bitmapOffset = headerSize;
-    header->handleTableOffset = headerSize + bitmapSize;
-    header->dataOffset = headerSize + bitmapSize + handleTableSize;
+/**
+ * @brief Get pointer to the timer wheel
+ * @param header Pointer to RMA header structure with TTL support (must not be NULL)
+ * @return Pointer to the wheel
+ */
+static struct rma_timer_wheel_t* rma_getTimerWheel(struct rma_mem_header_t *header){
+    return (struct rma_timer_wheel_t*)((char*)header + header->timerWheelOffset);
+}
 
-    // Fix the numBlocks calculation
-    size_t const remainingSpace = totalSize - header->dataOffset;
-    header->numBlocks = remainingSpace / blockSize;
+/**
+ * @brief File a block with a pending expiry into the timer wheel
+ * @param header Pointer to RMA header structure with TTL support (must not be NULL)
+ * @param blockIndex Block whose ttl entry has its expiry set and is unlinked
+ *
+ * Picks the lowest level whose range covers the remaining delay. A slot
+ * of level n is cascaded at the tick its block would expire rounded down
+ * to a multiple of RMA_TTL_WHEEL_SLOTS^n, which always lies after the
+ * current tick, so nothing fires early.
+ */
+static void rma_ttlLink(struct rma_mem_header_t *header, size_t blockIndex){
+    struct rma_ttl_entry_t *table = rma_getTtlTable(header);
+    struct rma_timer_wheel_t *wheel = rma_getTimerWheel(header);
+    struct rma_ttl_entry_t *entry = &table[blockIndex];
 
-    // Clear the bitmap
-    memset((char*)memPool + header->bitmapOffset, 0, (header->numBlocks + 7) / 8);
+    uint64_t const delta = entry->expiry > header->currentTick ? entry->expiry - header->currentTick : 0;
+    uint64_t target = entry->expiry;
 
-    return header;
-}
+    size_t level = 0;
+    while (level + 1 < RMA_TTL_WHEEL_LEVELS && delta >= (uint64_t)1 << (RMA_TTL_SLOT_BITS * (level + 1))) level++;
 
-rma_handle_t rma_alloc(struct rma_mem_header_t *header){
-    /*
-        CHECKS
-    */
+    // delays beyond the top level park in its furthest slot and are re-filed when it cascades
+    uint64_t const range = (uint64_t)1 << (RMA_TTL_SLOT_BITS * RMA_TTL_WHEEL_LEVELS);
+    if (delta >= range) target = header->currentTick + range - 1;
 
-    // validate the provided header
-    if (header == NULL) return RMA_INVALID_HANDLE;
+    size_t const slot = (size_t)(target >> (RMA_TTL_SLOT_BITS * level)) & (RMA_TTL_WHEEL_SLOTS - 1);
+    size_t const headIndex = level * RMA_TTL_WHEEL_SLOTS + slot;
 
-    // check if blocks are available
-    if (header->numAllocated >= header->numBlocks){
-        // In the future, it will expand the arena. For now, a simple debug message will do.
-        printf("\nMax block count reached. Can't allocate more blocks.");
-        return RMA_INVALID_HANDLE;
-    }
+    entry->prev = RMA_TTL_HEAD_FLAG | (uint32_t)headIndex;
+    entry->next = wheel->heads[headIndex];
+    if (entry->next) table[entry->next - 1].prev = (uint32_t)blockIndex + 1;
 
-    // check for nextHandle overflow
-    if (header->nextHandle == 0) return RMA_INVALID_HANDLE;
+    wheel->heads[headIndex] = (uint32_t)blockIndex + 1;
+    wheel->occupied[level] |= (uint64_t)1 << slot;
+}
 
-    /*
-        FREE BLOCK FINDING
-    */
-    uint32_t *bitmap = rma_getBitmap(header);
-    size_t freeBlockIndex = 0;
+/**
+ * @brief Remove a block from its timer wheel slot
+ * @param header Pointer to RMA header structure with TTL support (must not be NULL)
+ * @param blockIndex Block that is currently linked
+ */
+static void rma_ttlUnlink(struct rma_mem_header_t *header, size_t blockIndex){
+    struct rma_ttl_entry_t *table = rma_getTtlTable(header);
+    struct rma_timer_wheel_t *wheel = rma_getTimerWheel(header);
+    struct rma_ttl_entry_t *entry = &table[blockIndex];
 
-    // find the first free block
-    for (size_t blockIndex = 0; blockIndex < header->numBlocks; blockIndex++){
-        if (rma_isBlockAllocated(bitmap, blockIndex) == 0){
-            freeBlockIndex = blockIndex;
-            break;
-        }
+    if (entry->next) table[entry->next - 1].prev = entry->prev;
+
+    if (entry->prev & RMA_TTL_HEAD_FLAG){
+        size_t const headIndex = entry->prev & ~RMA_TTL_HEAD_FLAG;
+        wheel->heads[headIndex] = entry->next;
+        if (entry->next == 0) wheel->occupied[headIndex / RMA_TTL_WHEEL_SLOTS] &= ~((uint64_t)1 << (headIndex % RMA_TTL_WHEEL_SLOTS));
+    }
+    else {
+        table[entry->prev - 1].next = entry->next;
     }
 
-    /*
-        GENERATE SECURE HANDLE
-    */
-    uint16_t const salt = rma_generateSalt(header);
+    entry->next = 0;
+    entry->prev = 0;
+}
 
-    // make sure we got a valid salt
-    if (salt == 0){
-        printf("\nSalt generation failed.\n");
-        return RMA_INVALID_HANDLE;
+/**
+ * @brief Re-file every block of a higher level slot relative to the current tick
+ * @param header Pointer to RMA header structure with TTL support (must not be NULL)
+ * @param level Wheel level (> 0)
+ * @param slot Slot within the level
+ */
+static void rma_ttlCascade(struct rma_mem_header_t *header, size_t level, size_t slot){
+    struct rma_ttl_entry_t *table = rma_getTtlTable(header);
+    struct rma_timer_wheel_t *wheel = rma_getTimerWheel(header);
+    size_t const headIndex = level * RMA_TTL_WHEEL_SLOTS + slot;
+
+    // detach the whole list, then link its blocks again
+    uint32_t link = wheel->heads[headIndex];
+    wheel->heads[headIndex] = 0;
+    wheel->occupied[level] &= ~((uint64_t)1 << slot);
+
+    while (link){
+        size_t const blockIndex = link - 1;
+        link = table[blockIndex].next;
+        rma_ttlLink(header, blockIndex);
     }
+}
 
-    // combine salt with block index
-    uint32_t const handle = (salt << 16) | header->nextHandle;
+/**
+ * @brief Find the next tick at which rma_expire() has work to do
+ * @param header Pointer to RMA header structure with TTL support (must not be NULL)
+ * @param limit Tick returned when nothing is due earlier
+ * @return Earliest tick after header->currentTick that reaches an occupied
+ *         level 0 slot or cascades an occupied higher level slot, capped at limit
+ *
+ * Level n slot s is cascaded at the next tick that is a multiple of
+ * RMA_TTL_WHEEL_SLOTS^n with s as its level n digit. Rotating each
+ * occupancy mask to start after the current position finds that slot
+ * with a single count of trailing zeros, so empty slots and boundaries of
+ * empty levels are skipped whatever their distance.
+ */
+static uint64_t rma_ttlNextTick(struct rma_mem_header_t *header, uint64_t limit){
+    struct rma_timer_wheel_t const *wheel = rma_getTimerWheel(header);
+    uint64_t const slotMask = RMA_TTL_WHEEL_SLOTS - 1;
+    uint64_t tick = limit;
+
+    for (size_t level = 0; level < RMA_TTL_WHEEL_LEVELS; level++){
+        uint64_t const occupied = wheel->occupied[level];
+        if (occupied == 0) continue;
+
+        unsigned const bits = RMA_TTL_SLOT_BITS * (unsigned)level;
+        uint64_t const position = (header->currentTick >> bits) + 1;
+        unsigned const shift = (unsigned)(position & slotMask);
+        uint64_t const pending = shift ? (occupied >> shift) | (occupied << (64 - shift)) : occupied;
+        uint64_t const slot = position + (uint64_t)__builtin_ctzll(pending);
+
+        // a boundary past the end of the clock lies beyond any limit
+        if (slot > UINT64_MAX >> bits) continue;
+        if (slot << bits < tick) tick = slot << bits;
+    }
+
+    return tick;
+}
+
+/**
+ * @brief Get pointer to the referenced-block bitmap
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @return Pointer to the bitmap, or NULL if the pool has no eviction support
+ */
+static uint32_t* rma_getRefBitmap(struct rma_mem_header_t *header){
+    if (header->refBitmapOffset == 0) return NULL;
+    return (uint32_t*)((char*)header + header->refBitmapOffset);
+}
+
+/**
+ * @brief Record an access to a block for CLOCK eviction
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param blockIndex Index of the accessed block
+ *
+ * Skips the store when the bit is already set so hot blocks do not keep
+ * dirtying the bitmap's cache line.
+ */
+static void rma_markReferenced(struct rma_mem_header_t *header, size_t blockIndex){
+    uint32_t *refBitmap = rma_getRefBitmap(header);
+    if (refBitmap && !rma_isBlockAllocated(refBitmap, blockIndex)) rma_markBlockAllocated(refBitmap, blockIndex);
+}
+
+/**
+ * @brief Hash the contents of a block
+ * @param data Block contents (must not be NULL)
+ * @param size Number of bytes to hash
+ * @return Non-zero 64 bit hash (0 marks unindexed blocks)
+ *
+ * One multiply-rotate round per 8 bytes and a final avalanche: fast, not
+ * collision resistant, so matches are always confirmed with memcmp().
+ */
+static uint64_t rma_hashBlock(void const *data, size_t size){
+    unsigned char const *bytes = data;
+    uint64_t hash = 0x9E3779B97F4A7C15ull ^ size;
+
+    size_t offset = 0;
+    for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)){
+        uint64_t word;
+        memcpy(&word, bytes + offset, sizeof(word));
+        hash ^= word * 0x87C37B91114253D5ull;
+        hash = ((hash << 31) | (hash >> 33)) * 0x4CF5AD432745937Full;
+    }
+    for (; offset < size; offset++) hash = (hash ^ bytes[offset]) * 0x100000001B3ull;
+
+    hash = rma_dedupMix(hash);
+    return hash ? hash : 1;
+}
+
+/**
+ * @brief Add a block to the content index
+ * @param header Pointer to RMA header structure with dedup (must not be NULL)
+ * @param hash Content hash of the block
+ * @param owner Handle owning the block
+ */
+static void rma_dedupIndexInsert(struct rma_mem_header_t *header, uint64_t hash, rma_handle_t owner){
+    struct rma_dedup_entry_t *index = rma_getDedupIndex(header);
+    size_t const mask = header->dedupCapacity - 1;
+
+    // at most one entry per block, so the table never fills up
+    size_t slot = hash & mask;
+    while (index[slot].owner != 0) slot = (slot + 1) & mask;
+
+    index[slot] = (struct rma_dedup_entry_t){ hash, owner, 0 };
+}
+
+/**
+ * @brief Find the content index slot of a block
+ * @param header Pointer to RMA header structure with dedup (must not be NULL)
+ * @param hash Content hash the block was indexed under
+ * @param owner Handle owning the block
+ * @return Slot index, or SIZE_MAX if not indexed
+ */
+static size_t rma_dedupIndexFind(struct rma_mem_header_t *header, uint64_t hash, rma_handle_t owner){
+    struct rma_dedup_entry_t const *index = rma_getDedupIndex(header);
+    size_t const mask = header->dedupCapacity - 1;
+
+    for (size_t slot = hash & mask, probes = 0; probes <= mask && index[slot].owner != 0; slot = (slot + 1) & mask, probes++){
+        if (index[slot].hash == hash && index[slot].owner == owner) return slot;
+    }
+
+    return SIZE_MAX;
+}
+
+/**
+ * @brief Remove a block from the content index
+ * @param header Pointer to RMA header structure with dedup (must not be NULL)
+ * @param blockIndex Indexed block
+ *
+ * Linear probing with backward-shift deletion: later entries of the probe
+ * chain move into the hole, so lookups never need tombstones.
+ */
+static void rma_dedupIndexRemove(struct rma_mem_header_t *header, size_t blockIndex){
+    struct rma_dedup_block_t *block = &rma_getDedupBlocks(header)[blockIndex];
+    if (block->hash == 0) return;
+
+    struct rma_dedup_entry_t *index = rma_getDedupIndex(header);
+    size_t const mask = header->dedupCapacity - 1;
+
+    size_t hole = rma_dedupIndexFind(header, block->hash, rma_getHandleTable(header)[blockIndex]);
+    block->hash = 0;
+    if (hole == SIZE_MAX) return;
+
+    for (size_t slot = (hole + 1) & mask; index[slot].owner != 0; slot = (slot + 1) & mask){
+        size_t const home = index[slot].hash & mask;
+
+        // the entry may fill the hole only if that does not move it before its home slot
+        if (((slot - home) & mask) >= ((slot - hole) & mask)){
+            index[hole] = index[slot];
+            hole = slot;
+        }
+    }
+    index[hole] = (struct rma_dedup_entry_t){0};
+    rma_statAdd(&header->numIndexed, -1);
+}
+
+/**
+ * @brief Remove one entry from the alias table
+ * @param header Pointer to RMA header structure with dedup (must not be NULL)
+ * @param hole Slot to clear (from rma_dedupFindAlias())
+ */
+static void rma_dedupAliasRemove(struct rma_mem_header_t *header, size_t hole){
+    struct rma_dedup_alias_t *aliases = rma_getDedupAliases(header);
+    size_t const mask = header->dedupCapacity - 1;
+
+    for (size_t slot = (hole + 1) & mask; aliases[slot].alias != 0; slot = (slot + 1) & mask){
+        size_t const home = rma_dedupMix(aliases[slot].alias) & mask;
+
+        if (((slot - home) & mask) >= ((slot - hole) & mask)){
+            aliases[hole] = aliases[slot];
+            hole = slot;
+        }
+    }
+    aliases[hole] = (struct rma_dedup_alias_t){0};
+}
+
+/**
+ * @brief Add an alias to the alias table
+ * @param header Pointer to RMA header structure with dedup (must not be NULL)
+ * @param alias Handle that no longer owns a block
+ * @param owner Handle owning the shared block
+ */
+static void rma_dedupAliasInsert(struct rma_mem_header_t *header, rma_handle_t alias, rma_handle_t owner){
+    struct rma_dedup_alias_t *aliases = rma_getDedupAliases(header);
+    size_t const mask = header->dedupCapacity - 1;
+
+    size_t slot = rma_dedupMix(alias) & mask;
+    while (aliases[slot].alias != 0) slot = (slot + 1) & mask;
+
+    aliases[slot] = (struct rma_dedup_alias_t){ alias, owner };
+}
+
+/**
+ * @brief Detach one handle from a block other handles still share
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param blockIndex Block the handle resolves to
+ * @param handle Handle to detach (owner or alias of the block)
+ * @return 1 if the handle was detached, 0 if it is the block's only reference
+ *
+ * When the owner leaves, one alias inherits the block: it takes over the
+ * handle table slot and the index entry, and the remaining aliases are
+ * repointed to it.
+ */
+static int rma_dedupDetach(struct rma_mem_header_t *header, size_t blockIndex, rma_handle_t handle){
+    struct rma_dedup_block_t *blocks = rma_getDedupBlocks(header);
+    if (blocks == NULL || blocks[blockIndex].shares == 0) return 0;
+
+    uint32_t *handleTable = rma_getHandleTable(header);
+    struct rma_dedup_alias_t *aliases = rma_getDedupAliases(header);
+
+    if (handleTable[blockIndex] == handle){
+        rma_handle_t heir = 0;
+        for (size_t slot = 0; slot < header->dedupCapacity; slot++){
+            if (aliases[slot].alias == 0 || aliases[slot].owner != handle) continue;
+            if (heir == 0) heir = aliases[slot].alias;
+            aliases[slot].owner = heir;
+        }
+
+        size_t const indexSlot = blocks[blockIndex].hash ? rma_dedupIndexFind(header, blocks[blockIndex].hash, handle) : SIZE_MAX;
+        if (indexSlot != SIZE_MAX) rma_getDedupIndex(header)[indexSlot].owner = heir;
+
+        handleTable[blockIndex] = heir;
+        handle = heir;
+    }
+
+    rma_dedupAliasRemove(header, rma_dedupFindAlias(header, handle));
+    blocks[blockIndex].shares--;
+    rma_statAdd(&header->numAliases, -1);
+
+    return 1;
+}
+
+/**
+ * @brief Thin wrapper around the futex system call
+ * @param word Futex word
+ * @param operation FUTEX_WAIT or FUTEX_WAKE
+ * @param value Expected value (wait) or number of threads to wake (wake)
+ * @param timeout Relative timeout for FUTEX_WAIT, or NULL to wait forever
+ * @return System call result
+ */
+static long rma_futex(uint32_t *word, int operation, uint32_t value, struct timespec const *timeout){
+    return syscall(SYS_futex, word, operation, value, timeout, NULL, 0);
+}
+
+/**
+ * @brief Lock a pool created with options.threadSafe
+ * @param header Pointer to RMA header structure (may be NULL)
+ * @return Guard to pass to rma_poolUnlock()
+ *
+ * Three-state futex lock (0 free, 1 locked, 2 contended): uncontended
+ * lock and unlock are a single atomic each, only contention enters the
+ * kernel. Pools without threadSafe and pools this thread already holds
+ * (re-entry from a callback) are not locked again.
+ */
+static struct rma_pool_guard_t rma_poolLock(struct rma_mem_header_t *header){
+    struct rma_pool_guard_t guard = { NULL, rma_heldPool };
+    if (header == NULL || !header->options.threadSafe || header == rma_heldPool) return guard;
+
+    uint32_t state = 0;
+    if (!__atomic_compare_exchange_n(&header->lockWord, &state, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)){
+        if (state != 2) state = __atomic_exchange_n(&header->lockWord, 2, __ATOMIC_ACQUIRE);
+        while (state != 0){
+            rma_futex(&header->lockWord, FUTEX_WAIT, 2, NULL);
+            state = __atomic_exchange_n(&header->lockWord, 2, __ATOMIC_ACQUIRE);
+        }
+    }
+
+    guard.header = header;
+    rma_heldPool = header;
+    return guard;
+}
+
+/**
+ * @brief Release a lock taken by rma_poolLock()
+ * @param guard Guard returned by rma_poolLock()
+ */
+static void rma_poolUnlock(struct rma_pool_guard_t guard){
+    if (guard.header == NULL) return;
+
+    rma_heldPool = guard.previous;
+    if (__atomic_fetch_sub(&guard.header->lockWord, 1, __ATOMIC_RELEASE) != 1){
+        __atomic_store_n(&guard.header->lockWord, 0, __ATOMIC_RELEASE);
+        rma_futex(&guard.header->lockWord, FUTEX_WAKE, 1, NULL);
+    }
+}
+
+/**
+ * @brief Find the rma_lock() stripe of a handle
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param handle Handle to lock
+ * @return The stripe, or NULL if the pool has no lock table or the handle is invalid
+ *
+ * Fibonacci hashing spreads consecutive handle counters over all stripes.
+ */
+static struct rma_lock_stripe_t* rma_getLockStripe(struct rma_mem_header_t *header, rma_handle_t handle){
+    if (header->lockTableOffset == 0 || handle == RMA_INVALID_HANDLE) return NULL;
+
+    size_t const stripe = ((uint32_t)(handle * 0x9E3779B1u) >> 20) & (header->options.lockStripes - 1);
+    return (struct rma_lock_stripe_t*)((char*)header + header->lockTableOffset) + stripe;
+}
+
+/**
+ * @brief Tell blocked allocators and the event fd that a block was freed
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param wasFull Nonzero if the pool was full before the release
+ *
+ * Only called when somebody listens, so plain frees pay two loads.
+ */
+static void rma_notifyFree(struct rma_mem_header_t *header, int wasFull){
+    if (__atomic_load_n(&header->waiters, __ATOMIC_RELAXED) > 0){
+        __atomic_fetch_add(&header->freeSequence, 1, __ATOMIC_RELEASE);
+        rma_futex(&header->freeSequence, FUTEX_WAKE, 1, NULL);
+    }
+
+    // the event fd only signals the transition out of exhaustion
+    if (wasFull && header->eventFd >= 0){
+        uint64_t const one = 1;
+        ssize_t const written = write(header->eventFd, &one, sizeof(one));
+        (void)written; // a saturated counter is still readable
+    }
+}
+
+/**
+ * @brief Hand a free block out under the given handle
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param blockIndex Index of a free block (must be < numBlocks)
+ * @param handle Handle to assign to the block
+ *
+ * Single place that marks a block allocated: bitmap, handle table, side
+ * arrays and statistics. Every allocation path goes through here.
+ */
+static void rma_claimBlock(struct rma_mem_header_t *header, size_t blockIndex, rma_handle_t handle){
+    rma_getHandleTable(header)[blockIndex] = handle;
+
+    uint32_t *epochTable = rma_getEpochTable(header);
+    if (epochTable) epochTable[blockIndex] = header->currentEpoch;
+
+    rma_statAdd(&header->numAllocated, 1);
+    rma_statAdd(&header->usedSize, (ptrdiff_t)header->blockSize);
+
+    rma_markBlockAllocated(rma_getBitmap(header), blockIndex);
+
+    if (header->statsPage) rma_statsPageUpdate(header, 1, 0, 0);
+}
+
+/**
+ * @brief Return an allocated block to the free state
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param blockIndex Index of an allocated block (must be < numBlocks)
+ *
+ * Counterpart of rma_claimBlock(); every free path goes through here.
+ */
+static void rma_releaseBlock(struct rma_mem_header_t *header, size_t blockIndex){
+    // the block's aliases die with it, just like its own handle
+    struct rma_dedup_block_t *dedupBlocks = rma_getDedupBlocks(header);
+    if (dedupBlocks){
+        rma_dedupIndexRemove(header, blockIndex);
+
+        rma_handle_t const owner = rma_getHandleTable(header)[blockIndex];
+        struct rma_dedup_alias_t *aliases = rma_getDedupAliases(header);
+        for (size_t slot = 0; dedupBlocks[blockIndex].shares > 0 && slot < header->dedupCapacity; ){
+            if (aliases[slot].alias != 0 && aliases[slot].owner == owner){
+                rma_dedupAliasRemove(header, slot); // refills this slot, look at it again
+                dedupBlocks[blockIndex].shares--;
+                rma_statAdd(&header->numAliases, -1);
+            }
+            else slot++;
+        }
+    }
+
+    rma_markBlockFree(rma_getBitmap(header), blockIndex);
+    rma_markBlockFree(rma_getPinnedBitmap(header), blockIndex);
+    rma_getHandleTable(header)[blockIndex] = 0; // Clear the handle
+
+    uint32_t *epochTable = rma_getEpochTable(header);
+    if (epochTable) epochTable[blockIndex] = 0;
+
+    uint32_t *sizeTable = rma_getSizeTable(header);
+    if (sizeTable) __atomic_store_n(&sizeTable[blockIndex], 0, __ATOMIC_RELAXED);
+
+    unsigned char *metaTable = rma_getMetaTable(header);
+    if (metaTable) memset(metaTable + blockIndex * header->options.metaWidth, 0, header->options.metaWidth);
+
+    uint32_t *refBitmap = rma_getRefBitmap(header);
+    if (refBitmap) rma_markBlockFree(refBitmap, blockIndex);
+
+    struct rma_ttl_entry_t *ttlTable = rma_getTtlTable(header);
+    if (ttlTable && ttlTable[blockIndex].expiry){
+        rma_ttlUnlink(header, blockIndex);
+        ttlTable[blockIndex].expiry = 0;
+        rma_statAdd(&header->numTimers, -1);
+    }
+
+    // Update statistics
+    int const wasFull = header->numAllocated == header->numBlocks;
+    rma_statAdd(&header->numAllocated, -1);
+    rma_statAdd(&header->usedSize, -(ptrdiff_t)header->blockSize);
+
+    if (__atomic_load_n(&header->waiters, __ATOMIC_RELAXED) > 0 || header->eventFd >= 0) rma_notifyFree(header, wasFull);
+
+    if (header->statsPage) rma_statsPageUpdate(header, 0, 1, 0);
+}
+
+/**
+ * @brief Append an allocation to the calling thread's transaction log
+ * @param header Pool the block was allocated from
+ * @param handle Freshly allocated handle
+ * @return 1 on success, 0 if the log could not grow
+ */
+static int rma_txRecord(struct rma_mem_header_t *header, rma_handle_t handle){
+    if (rma_txLog.count == rma_txLog.capacity){
+        size_t const capacity = rma_txLog.capacity ? rma_txLog.capacity * 2 : 64;
+        struct rma_tx_entry_t *entries = realloc(rma_txLog.entries, capacity * sizeof(*entries));
+        if (entries == NULL) return 0;
+
+        rma_txLog.entries = entries;
+        rma_txLog.capacity = capacity;
+    }
+
+    rma_txLog.entries[rma_txLog.count++] = (struct rma_tx_entry_t){ header, handle };
+    return 1;
+}
+
+/**
+ * @brief Drop a handle that is freed while a transaction is open
+ * @param header Pool the handle belongs to
+ * @param handle Handle being freed
+ *
+ * Leaves a tombstone so an abort doesn't free the block a second time.
+ */
+static void rma_txForget(struct rma_mem_header_t *header, rma_handle_t handle){
+    // recent allocations are the most likely to be freed, search backwards
+    for (size_t i = rma_txLog.count; i > 0; i--){
+        struct rma_tx_entry_t *entry = &rma_txLog.entries[i - 1];
+        if (entry->handle == handle && entry->header == header){
+            entry->handle = RMA_INVALID_HANDLE;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief qsort() comparator ordering log entries by pool, then handle
+ */
+static int rma_txCompareEntries(void const *a, void const *b){
+    struct rma_tx_entry_t const *left = a;
+    struct rma_tx_entry_t const *right = b;
+
+    if (left->header != right->header) return (uintptr_t)left->header < (uintptr_t)right->header ? -1 : 1;
+    if (left->handle != right->handle) return left->handle < right->handle ? -1 : 1;
+    return 0;
+}
+
+/**
+ * @brief Release the blocks of a sorted run of log entries from one pool
+ * @param header Pool to sweep (must not be NULL)
+ * @param entries Entries of this pool, sorted by handle
+ * @param count Number of entries
+ * @return Number of blocks freed
+ *
+ * One pass over the pool, with a binary search of each allocated block's
+ * handle among the logged handles.
+ */
+static size_t rma_txReleaseBatch(struct rma_mem_header_t *header, struct rma_tx_entry_t const *entries, size_t count){
+    uint32_t *bitmap = rma_getBitmap(header);
+    uint32_t const *handleTable = rma_getHandleTable(header);
+    size_t freed = 0;
+
+    // logged handles merged into other blocks only drop their alias
+    for (size_t i = 0; header->numAliases > 0 && i < count; i++){
+        if (entries[i].handle == RMA_INVALID_HANDLE || rma_dedupFindAlias(header, entries[i].handle) == SIZE_MAX) continue;
+        rma_dedupDetach(header, rma_findBlockByHandle(header, entries[i].handle), entries[i].handle);
+        freed++;
+    }
+
+    for (size_t blockIndex = 0; blockIndex < header->numBlocks && freed < count; blockIndex++){
+        if (!rma_isBlockAllocated(bitmap, blockIndex)) continue;
+
+        // binary search for this block's handle
+        size_t low = 0, high = count;
+        while (low < high){
+            size_t const middle = low + (high - low) / 2;
+
+            if (entries[middle].handle < handleTable[blockIndex]) low = middle + 1;
+            else high = middle;
+        }
+
+        if (low < count && entries[low].handle == handleTable[blockIndex]){
+            // a shared block stays with its other handles
+            if (!rma_dedupDetach(header, blockIndex, entries[low].handle)) rma_releaseBlock(header, blockIndex);
+            freed++;
+        }
+    }
+
+    return freed;
+}
+
+/**
+ * @brief Find the next block at or after a given index with the wanted state
+ * @param bitmap Pointer to bitmap array (must not be NULL)
+ * @param from First block index to look at
+ * @param limit Number of valid blocks (search stops here)
+ * @param allocated 1 to look for an allocated block, 0 for a free one
+ * @return Index of the found block, or limit if there is none
+ *
+ * Scans a whole bitmap word per step using count-trailing-zeros.
+ */
+static size_t rma_findNextBlock(uint32_t const *bitmap, size_t from, size_t limit, int allocated){
+    while (from < limit){
+        uint32_t word = bitmap[from / 32];
+        if (!allocated) word = ~word;
+
+        // ignore the bits below 'from'
+        word &= ~0u << (from % 32);
+
+        if (word != 0){
+            size_t const found = (from & ~(size_t)31) + (size_t)__builtin_ctz(word);
+            return found < limit ? found : limit;
+        }
+
+        from = (from & ~(size_t)31) + 32;
+    }
+
+    return limit;
+}
+
+/**
+ * @brief Collect the contiguous runs of allocated blocks
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param runs Output array, or NULL to only count
+ * @return Number of runs
+ */
+static size_t rma_collectAllocatedRuns(struct rma_mem_header_t *header, struct rma_block_run_t *runs){
+    uint32_t const *bitmap = rma_getBitmap(header);
+    size_t const numBlocks = header->numBlocks;
+    size_t numRuns = 0;
+
+    for (size_t blockIndex = 0; blockIndex < numBlocks; ){
+        size_t const first = rma_findNextBlock(bitmap, blockIndex, numBlocks, 1);
+        if (first == numBlocks) break;
+
+        size_t const end = rma_findNextBlock(bitmap, first, numBlocks, 0);
+        if (runs) runs[numRuns] = (struct rma_block_run_t){ first, end - first };
+        numRuns++;
+
+        blockIndex = end;
+    }
+
+    return numRuns;
+}
+
+/**
+ * @brief Find the last allocated, unpinned block below a given index
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param before Exclusive upper bound of the search
+ * @return Index of the found block, or SIZE_MAX if there is none
+ *
+ * Reverse word-level scan used by rma_compact() to pick blocks to move.
+ */
+static size_t rma_findPrevMovableBlock(struct rma_mem_header_t *header, size_t before){
+    uint32_t const *bitmap = rma_getBitmap(header);
+    uint32_t const *pinned = rma_getPinnedBitmap(header);
+
+    while (before > 0){
+        size_t const last = before - 1;
+        uint32_t word = bitmap[last / 32] & ~pinned[last / 32];
+
+        // ignore the bits at and above 'before'
+        uint32_t const bit = (uint32_t)(last % 32);
+        if (bit < 31) word &= (1u << (bit + 1)) - 1;
+
+        if (word != 0) return (last & ~(size_t)31) + 31 - (size_t)__builtin_clz(word);
+
+        before = last & ~(size_t)31;
+    }
+
+    return SIZE_MAX;
+}
+
+/**
+ * @brief Move an allocated block to a free slot, keeping its handle
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param from Index of an allocated block
+ * @param to Index of a free block
+ *
+ * Copies the data and every per-block entry (handle, side arrays).
+ * The handle resolves to the new slot afterwards since lookups go by the
+ * handle table.
+ * Statistics are unchanged.
+ */
+static void rma_moveBlock(struct rma_mem_header_t *header, size_t from, size_t to){
+    memcpy(rma_getBlockPtr(header, to), rma_getBlockPtr(header, from), header->blockSize);
 
-    /*
-        UPDATE ALL DATA STRUCTURES
-    */
     uint32_t *handleTable = rma_getHandleTable(header);
+    handleTable[to] = handleTable[from];
+    handleTable[from] = 0;
+
+    uint32_t *epochTable = rma_getEpochTable(header);
+    if (epochTable){
+        epochTable[to] = epochTable[from];
+        epochTable[from] = 0;
+    }
+
+    uint32_t *sizeTable = rma_getSizeTable(header);
+    if (sizeTable){
+        __atomic_store_n(&sizeTable[to], sizeTable[from], __ATOMIC_RELAXED);
+        __atomic_store_n(&sizeTable[from], 0, __ATOMIC_RELAXED);
+    }
+
+    unsigned char *metaTable = rma_getMetaTable(header);
+    if (metaTable){
+        size_t const width = header->options.metaWidth;
+        memcpy(metaTable + to * width, metaTable + from * width, width);
+        memset(metaTable + from * width, 0, width);
+    }
+
+    // index and aliases refer to the owner handle, which moves along
+    struct rma_dedup_block_t *dedupBlocks = rma_getDedupBlocks(header);
+    if (dedupBlocks){
+        dedupBlocks[to] = dedupBlocks[from];
+        dedupBlocks[from] = (struct rma_dedup_block_t){0};
+    }
+
+    uint32_t *refBitmap = rma_getRefBitmap(header);
+    if (refBitmap && rma_isBlockAllocated(refBitmap, from)){
+        rma_markBlockAllocated(refBitmap, to);
+        rma_markBlockFree(refBitmap, from);
+    }
+
+    // a pending expiry keeps its wheel slot, only the neighbours are repointed
+    struct rma_ttl_entry_t *ttlTable = rma_getTtlTable(header);
+    if (ttlTable && ttlTable[from].expiry){
+        struct rma_ttl_entry_t const entry = ttlTable[from];
+        ttlTable[to] = entry;
+        ttlTable[from] = (struct rma_ttl_entry_t){0};
+
+        if (entry.next) ttlTable[entry.next - 1].prev = (uint32_t)to + 1;
+        if (entry.prev & RMA_TTL_HEAD_FLAG) rma_getTimerWheel(header)->heads[entry.prev & ~RMA_TTL_HEAD_FLAG] = (uint32_t)to + 1;
+        else ttlTable[entry.prev - 1].next = (uint32_t)to + 1;
+    }
+
+    uint32_t *bitmap = rma_getBitmap(header);
+    rma_markBlockAllocated(bitmap, to);
+    rma_markBlockFree(bitmap, from);
+}
+
+/**
+ * @brief Release the pages of free block runs back to the OS
+ * @param header Pointer to an mmap-backed RMA header (must not be NULL)
+ * @return Number of bytes advised away
+ *
+ * Only whole pages fully covered by free blocks are released with
+ * MADV_DONTNEED; they read back as zeroes when reused.
+ */
+static size_t rma_adviseFreeRuns(struct rma_mem_header_t *header){
+    uint32_t const *bitmap = rma_getBitmap(header);
+    size_t const pageSize = header->mapGranularity;
+    uintptr_t const dataStart = (uintptr_t)rma_getBlockPtr(header, 0);
+    size_t released = 0;
+
+    for (size_t blockIndex = 0; blockIndex < header->numBlocks; ){
+        size_t const first = rma_findNextBlock(bitmap, blockIndex, header->numBlocks, 0);
+        if (first == header->numBlocks) break;
+        size_t const end = rma_findNextBlock(bitmap, first, header->numBlocks, 1);
+
+        // shrink the run to whole pages
+        uintptr_t const runStart = (dataStart + first * header->blockStride + pageSize - 1) & ~(uintptr_t)(pageSize - 1);
+        uintptr_t const runEnd = (dataStart + end * header->blockStride) & ~(uintptr_t)(pageSize - 1);
+
+        if (runEnd > runStart && madvise((void*)runStart, runEnd - runStart, MADV_DONTNEED) == 0){
+            released += runEnd - runStart;
+        }
+
+        blockIndex = end;
+    }
+
+    return released;
+}
+
+/**
+ * @brief Thread entry copying the runs of one rma_clone() job
+ */
+static void* rma_cloneCopyRuns(void *argument){
+    struct rma_clone_job_t const *job = argument;
+
+    for (size_t i = 0; i < job->numRuns; i++){
+        size_t const offset = job->runs[i].first * job->blockStride;
+        memcpy(job->destination + offset, job->source + offset, job->runs[i].count * job->blockStride);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Old and new placement of one pool section during a resize
+ */
+struct rma_section_move_t {
+    size_t oldOffset;   /**< Current byte offset from the pool start */
+    size_t newOffset;   /**< Byte offset in the new layout */
+    size_t keepBytes;   /**< Leading bytes whose contents must be preserved */
+    size_t newBytes;    /**< Size of the section in the new layout */
+};
+
+/**
+ * @brief Move every metadata section and the data section to a new layout
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param layout New layout (offsets and block count)
+ *
+ * @warning The backing store must already be large enough for both layouts
+ *
+ * Sections are listed in address order. When growing, every section
+ * moves up, so they are moved from the last to the first; when shrinking
+ * they move down and are processed first to last. Either way a section
+ * never overwrites one that is still waiting to move. Bytes beyond the
+ * preserved prefix (new per-block entries) are zeroed, except for data.
+ */
+static void rma_relocateSections(struct rma_mem_header_t *header, struct rma_layout_t const *layout){
+    size_t const keptBlocks = header->numBlocks < layout->numBlocks ? header->numBlocks : layout->numBlocks;
+    size_t const keptBitmapBytes = (keptBlocks + 31) / 32 * sizeof(uint32_t);
+
+    struct rma_section_move_t sections[14];
+    size_t numSections = 0;
+
+    sections[numSections++] = (struct rma_section_move_t){ header->bitmapOffset, layout->bitmapOffset, keptBitmapBytes, 0 };
+    sections[numSections++] = (struct rma_section_move_t){ header->pinnedBitmapOffset, layout->pinnedBitmapOffset, keptBitmapBytes, 0 };
+    sections[numSections++] = (struct rma_section_move_t){ header->handleTableOffset, layout->handleTableOffset,
+        keptBlocks * sizeof(uint32_t), 0 };
+    if (layout->epochTableOffset){
+        sections[numSections++] = (struct rma_section_move_t){ header->epochTableOffset, layout->epochTableOffset,
+            keptBlocks * sizeof(uint32_t), 0 };
+    }
+    if (layout->sizeTableOffset){
+        sections[numSections++] = (struct rma_section_move_t){ header->sizeTableOffset, layout->sizeTableOffset,
+            keptBlocks * sizeof(uint32_t), 0 };
+    }
+    if (layout->metaTableOffset){
+        sections[numSections++] = (struct rma_section_move_t){ header->metaTableOffset, layout->metaTableOffset,
+            keptBlocks * header->options.metaWidth, 0 };
+    }
+    if (layout->ttlTableOffset){
+        sections[numSections++] = (struct rma_section_move_t){ header->ttlTableOffset, layout->ttlTableOffset,
+            keptBlocks * sizeof(struct rma_ttl_entry_t), 0 };
+        sections[numSections++] = (struct rma_section_move_t){ header->timerWheelOffset, layout->timerWheelOffset,
+            sizeof(struct rma_timer_wheel_t), 0 };
+    }
+    if (layout->refBitmapOffset){
+        sections[numSections++] = (struct rma_section_move_t){ header->refBitmapOffset, layout->refBitmapOffset, keptBitmapBytes, 0 };
+    }
+    if (layout->dedupBlocksOffset){
+        // the hash tables are only kept when their capacity doesn't change, rma_resize() rebuilds them otherwise
+        size_t const keptSlots = layout->dedupCapacity == header->dedupCapacity ? header->dedupCapacity : 0;
+        sections[numSections++] = (struct rma_section_move_t){ header->dedupBlocksOffset, layout->dedupBlocksOffset,
+            keptBlocks * sizeof(struct rma_dedup_block_t), 0 };
+        sections[numSections++] = (struct rma_section_move_t){ header->dedupIndexOffset, layout->dedupIndexOffset,
+            keptSlots * sizeof(struct rma_dedup_entry_t), 0 };
+        sections[numSections++] = (struct rma_section_move_t){ header->dedupAliasOffset, layout->dedupAliasOffset,
+            keptSlots * sizeof(struct rma_dedup_alias_t), 0 };
+    }
+    if (layout->lockTableOffset){
+        sections[numSections++] = (struct rma_section_move_t){ header->lockTableOffset, layout->lockTableOffset,
+            header->options.lockStripes * sizeof(struct rma_lock_stripe_t), 0 };
+    }
+    sections[numSections++] = (struct rma_section_move_t){ header->dataOffset, layout->dataOffset,
+        keptBlocks * header->blockStride, keptBlocks * header->blockStride };
+
+    // metadata sections in the new layout extend up to the next section
+    for (size_t i = 0; i + 1 < numSections; i++) sections[i].newBytes = sections[i + 1].newOffset - sections[i].newOffset;
+
+    char *base = (char*)header;
+    int const growing = layout->dataOffset >= header->dataOffset;
+
+    for (size_t step = 0; step < numSections; step++){
+        struct rma_section_move_t const *section = &sections[growing ? numSections - 1 - step : step];
+
+        memmove(base + section->newOffset, base + section->oldOffset, section->keepBytes);
+        memset(base + section->newOffset + section->keepBytes, 0, section->newBytes - section->keepBytes);
+    }
+
+    header->bitmapOffset = layout->bitmapOffset;
+    header->pinnedBitmapOffset = layout->pinnedBitmapOffset;
+    header->handleTableOffset = layout->handleTableOffset;
+    header->epochTableOffset = layout->epochTableOffset;
+    header->sizeTableOffset = layout->sizeTableOffset;
+    header->metaTableOffset = layout->metaTableOffset;
+    header->ttlTableOffset = layout->ttlTableOffset;
+    header->timerWheelOffset = layout->timerWheelOffset;
+    header->refBitmapOffset = layout->refBitmapOffset;
+    header->lockTableOffset = layout->lockTableOffset;
+    header->dedupBlocksOffset = layout->dedupBlocksOffset;
+    header->dedupIndexOffset = layout->dedupIndexOffset;
+    header->dedupAliasOffset = layout->dedupAliasOffset;
+    header->dedupCapacity = layout->dedupCapacity;
+    header->dataOffset = layout->dataOffset;
+    if (header->clockHand >= layout->numBlocks) header->clockHand = 0;
+    header->numBlocks = layout->numBlocks;
+}
+
+/**
+ * @brief Refill the dedup hash tables after rma_relocateSections() resized them
+ * @param header Pointer to RMA header structure with dedup (must not be NULL)
+ * @param aliases Alias entries saved before the relocation (may be NULL if there are none)
+ *
+ * The content index is rebuilt from the per-block hashes, which move with
+ * the blocks; aliases have no per-block home and are reinserted.
+ */
+static void rma_dedupRebuild(struct rma_mem_header_t *header, struct rma_dedup_alias_t const *aliases){
+    struct rma_dedup_block_t const *blocks = rma_getDedupBlocks(header);
+    uint32_t *bitmap = rma_getBitmap(header);
+    uint32_t const *handleTable = rma_getHandleTable(header);
+
+    header->numIndexed = 0;
+    for (size_t blockIndex = 0; blockIndex < header->numBlocks; blockIndex++){
+        if (!rma_isBlockAllocated(bitmap, blockIndex) || blocks[blockIndex].hash == 0) continue;
+
+        rma_dedupIndexInsert(header, blocks[blockIndex].hash, handleTable[blockIndex]);
+        rma_statAdd(&header->numIndexed, 1);
+    }
+
+    for (size_t i = 0; aliases && i < header->numAliases; i++) rma_dedupAliasInsert(header, aliases[i].alias, aliases[i].owner);
+}
+
+/**
+ * @brief Grow or shrink the backing store of a pool
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param newTotalSize Requested pool size in bytes
+ * @param mayMove Nonzero if the pool may be moved to a new address
+ * @return New pool address, or NULL on failure (pool unchanged)
+ *
+ * mmap pools use mremap(), shrinking in place so the tail pages go back to
+ * the OS. malloc pools use realloc(), or a copy when over-aligned. Pools
+ * in caller-owned memory can only use the buffer they were given.
+ */
+static struct rma_mem_header_t* rma_resizeBacking(struct rma_mem_header_t *header, size_t newTotalSize, int mayMove){
+    if (header->backing == RMA_BACKING_EXTERNAL) return newTotalSize <= header->mappedSize ? header : NULL;
+
+    if (header->backing == RMA_BACKING_MMAP){
+        size_t const granularity = header->mapGranularity;
+        size_t const newMappedSize = (newTotalSize + granularity - 1) / granularity * granularity;
+        if (newMappedSize == header->mappedSize) return header;
+
+        void *moved = mremap(header, header->mappedSize, newMappedSize, mayMove ? MREMAP_MAYMOVE : 0);
+        if (moved == MAP_FAILED) return NULL;
+
+        struct rma_mem_header_t *resized = moved;
+        resized->mappedSize = newMappedSize;
+        return resized;
+    }
+
+    size_t const alignment = header->options.alignment;
+    if (alignment <= _Alignof(max_align_t)){
+        struct rma_mem_header_t *resized = realloc(header, newTotalSize);
+        if (resized == NULL) return NULL;
+
+        resized->mappedSize = newTotalSize;
+        return resized;
+    }
+
+    // realloc() does not keep over-alignment, copy into a fresh aligned block
+    size_t const rounded = (newTotalSize + alignment - 1) & ~(alignment - 1);
+    struct rma_mem_header_t *resized = aligned_alloc(alignment, rounded);
+    if (resized == NULL) return NULL;
+
+    memcpy(resized, header, header->totalSize < newTotalSize ? header->totalSize : newTotalSize);
+    free(header);
+    resized->mappedSize = rounded;
+    return resized;
+}
+
+/**
+ * @brief Prefetch the first cache lines of a block
+ * @param block Start of the block
+ * @param blockSize Block size in bytes
+ * @param rw RMA_PREFETCH_READ or RMA_PREFETCH_WRITE
+ * @param locality Temporal locality hint 0 to 3 (clamped)
+ *
+ * __builtin_prefetch() needs compile-time constant hints, hence the switch.
+ */
+static void rma_prefetchBlock(void const *block, size_t blockSize, int rw, int locality){
+    size_t lines = (blockSize + 63) / 64;
+    if (lines > RMA_PREFETCH_MAX_LINES) lines = RMA_PREFETCH_MAX_LINES;
+
+    int const hint = (rw ? 4 : 0) | (locality < 0 ? 0 : locality > 3 ? 3 : locality);
+
+    for (size_t line = 0; line < lines; line++){
+        char const *address = (char const*)block + line * 64;
+
+        switch (hint){
+            case 0: __builtin_prefetch(address, 0, 0); break;
+            case 1: __builtin_prefetch(address, 0, 1); break;
+            case 2: __builtin_prefetch(address, 0, 2); break;
+            case 3: __builtin_prefetch(address, 0, 3); break;
+            case 4: __builtin_prefetch(address, 1, 0); break;
+            case 5: __builtin_prefetch(address, 1, 1); break;
+            case 6: __builtin_prefetch(address, 1, 2); break;
+            default: __builtin_prefetch(address, 1, 3); break;
+        }
+    }
+}
+
+/**
+ * @brief qsort() comparator for 16-bit salts
+ */
+static int rma_compareSalts(void const *a, void const *b){
+    return (int)*(uint16_t const*)a - (int)*(uint16_t const*)b;
+}
+
+/**
+ * @brief Obtain the backing memory for a pool according to its options
+ * @param totalSize Pool size in bytes
+ * @param options Pool options (must not be NULL)
+ * @param backing Output: RMA_BACKING_* that was actually used
+ * @param mappedSize Output: number of bytes reserved from the backing store
+ * @param mapGranularity Output: page size the mapping is made of (1 for malloc)
+ * @return Pointer to the backing memory, or NULL on failure
+ *
+ * malloc backing uses aligned_alloc() when the requested alignment exceeds
+ * what malloc() guarantees. mmap backing tries MAP_HUGETLB first when huge
+ * pages are requested and falls back to transparent huge pages.
+ */
+static void* rma_acquireBacking(size_t totalSize, struct rma_options_t const *options, int *backing, size_t *mappedSize, size_t *mapGranularity){
+    if (options->backing != RMA_BACKING_MMAP && !options->hugePages){
+        *backing = RMA_BACKING_MALLOC;
+        *mappedSize = totalSize;
+        *mapGranularity = 1;
+
+        if (options->alignment <= _Alignof(max_align_t)) return malloc(totalSize);
+
+        // aligned_alloc() wants the size to be a multiple of the alignment
+        size_t const rounded = (totalSize + options->alignment - 1) & ~(options->alignment - 1);
+        *mappedSize = rounded;
+        return aligned_alloc(options->alignment, rounded);
+    }
+
+    *backing = RMA_BACKING_MMAP;
+    size_t const pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    void *memPool = MAP_FAILED;
+
+    if (options->hugePages){
+        // explicit huge pages come in 2 MiB units on the common configurations
+        size_t const hugeSize = (totalSize + (2u << 20) - 1) & ~(size_t)((2u << 20) - 1);
+        memPool = mmap(NULL, hugeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (memPool != MAP_FAILED){
+            *mappedSize = hugeSize;
+            *mapGranularity = 2u << 20;
+        }
+    }
+
+    if (memPool == MAP_FAILED){
+        *mappedSize = (totalSize + pageSize - 1) & ~(pageSize - 1);
+        *mapGranularity = pageSize;
+        memPool = mmap(NULL, *mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memPool == MAP_FAILED) return NULL;
+
+        // no reserved huge pages, ask for transparent ones instead
+        if (options->hugePages) madvise(memPool, *mappedSize, MADV_HUGEPAGE);
+    }
+
+    return memPool;
+}
+
+/**
+ * @brief Allocate a block and report where it landed
+ * @param header Pointer to RMA header structure (may be NULL)
+ * @param blockIndexOut Optional output receiving the index of the claimed block
+ * @return Handle to the allocated block, or RMA_INVALID_HANDLE on failure
+ *
+ * Body of rma_alloc(); allocation variants that set up side arrays use the
+ * index instead of looking the fresh handle up again.
+ */
+static rma_handle_t rma_allocBlock(struct rma_mem_header_t *header, size_t *blockIndexOut){
+    /*
+        CHECKS
+    */
+
+    // validate the provided header
+    if (header == NULL) return RMA_INVALID_HANDLE;
+
+    // check if blocks are available
+    if (header->numAllocated >= header->numBlocks){
+        RMA_PROBE(alloc_fail, header, header->numAllocated, header->numBlocks);
+
+        // In the future, it will expand the arena. For now, a simple debug message will do.
+        printf("\nMax block count reached. Can't allocate more blocks.");
+        return RMA_INVALID_HANDLE;
+    }
+
+    // check for nextHandle overflow
+    if (header->nextHandle == 0) return RMA_INVALID_HANDLE;
+
+    /*
+        FREE BLOCK FINDING
+    */
+    uint32_t *bitmap = rma_getBitmap(header);
+    size_t freeBlockIndex = 0;
+
+    // find the first free block
+    for (size_t blockIndex = 0; blockIndex < header->numBlocks; blockIndex++){
+        if (rma_isBlockAllocated(bitmap, blockIndex) == 0){
+            freeBlockIndex = blockIndex;
+            break;
+        }
+    }
+
+    /*
+        GENERATE SECURE HANDLE
+    */
+    uint16_t const salt = rma_generateSalt(header);
+
+    // make sure we got a valid salt
+    if (salt == 0){
+        printf("\nSalt generation failed.\n");
+        return RMA_INVALID_HANDLE;
+    }
+
+    // combine salt, pool tag and handle counter (the counter only occupies the low 12 bits)
+    uint32_t const handle = ((uint32_t)salt << 16) | (header->poolTag << RMA_HANDLE_TAG_SHIFT) |
+                            (header->nextHandle & ((1u << RMA_HANDLE_TAG_SHIFT) - 1));
+
+    /*
+        UPDATE ALL DATA STRUCTURES
+    */
+    header->nextHandle++;
+    rma_claimBlock(header, freeBlockIndex, handle);
+
+    // inside a transaction the allocation must be logged so an abort can undo it
+    if (rma_txLog.depth > 0 && !rma_txRecord(header, handle)){
+        rma_releaseBlock(header, freeBlockIndex);
+        return RMA_INVALID_HANDLE;
+    }
+
+    if (blockIndexOut) *blockIndexOut = freeBlockIndex;
+    return handle;
+}
+
+/**
+ * @brief CLOCK sweep and allocation behind rma_allocOrEvict()
+ * @param header Pointer to RMA header structure with eviction support (must not be NULL)
+ * @param onEvict Optional callback run for the victim
+ * @param context User pointer passed to onEvict
+ * @return Handle to the allocated block, or RMA_INVALID_HANDLE if every block is pinned
+ */
+static rma_handle_t rma_evictAndAlloc(struct rma_mem_header_t *header, rma_block_callback_t onEvict, void *context){
+    if (header->numAllocated < header->numBlocks) return rma_allocBlock(header, NULL);
+
+    uint32_t *bitmap = rma_getBitmap(header);
+    uint32_t const *pinnedBitmap = rma_getPinnedBitmap(header);
+    uint32_t *refBitmap = rma_getRefBitmap(header);
+    size_t const numWords = (header->numBlocks + 31) / 32;
+
+    // two full turns are enough: the first clears every reference bit
+    size_t victim = SIZE_MAX;
+    for (size_t step = 0; step <= 2 * numWords && victim == SIZE_MAX; step++){
+        size_t const word = header->clockHand / 32;
+        uint32_t const fromHand = ~0u << (header->clockHand % 32);
+
+        uint32_t const movable = bitmap[word] & ~pinnedBitmap[word] & fromHand;
+        uint32_t const cold = movable & ~refBitmap[word];
+
+        if (cold){
+            victim = word * 32 + (size_t)__builtin_ctz(cold);
+            header->clockHand = victim + 1;
+        }
+        else {
+            // second chance for every block the hand passed
+            refBitmap[word] &= ~movable;
+            header->clockHand = (word + 1) * 32;
+        }
+
+        if (header->clockHand >= header->numBlocks) header->clockHand = 0;
+    }
+
+    if (victim == SIZE_MAX) return RMA_INVALID_HANDLE; // every block is pinned
+
+    rma_handle_t const victimHandle = rma_getHandleTable(header)[victim];
+    if (onEvict) onEvict(header, victimHandle, context);
+
+    // the callback may have freed the victim already
+    if (rma_getHandleTable(header)[victim] == victimHandle && rma_isBlockAllocated(bitmap, victim)) rma_releaseBlock(header, victim);
+
+    return rma_allocBlock(header, NULL);
+}
+
+/**
+ * @brief Resolve a handle to a block only it references, ready to be written
+ * @param header Pointer to RMA header structure (must not be NULL, pool lock held)
+ * @param handle Block handle
+ * @return Index of the block, or SIZE_MAX if the handle is invalid or a
+ *         shared block cannot be copied because the pool is full
+ *
+ * Body of rma_getPtrMut(): a deduplicated block is copied into a free
+ * block first, an exclusive one is dropped from the content index.
+ */
+static size_t rma_blockForWrite(struct rma_mem_header_t *header, rma_handle_t handle){
+    size_t blockIndex = rma_isValidHandle(header, handle) > 0 ? rma_findBlockByHandle(header, handle) : SIZE_MAX;
+    struct rma_dedup_block_t *dedupBlocks = rma_getDedupBlocks(header);
+
+    if (blockIndex != SIZE_MAX && dedupBlocks && dedupBlocks[blockIndex].shares > 0){
+        // shared: give this handle a private copy
+        size_t const copyIndex = header->numAllocated < header->numBlocks ?
+            rma_findNextBlock(rma_getBitmap(header), 0, header->numBlocks, 0) : header->numBlocks;
+
+        if (copyIndex < header->numBlocks){
+            rma_dedupDetach(header, blockIndex, handle);
+            rma_claimBlock(header, copyIndex, handle);
+            memcpy(rma_getBlockPtr(header, copyIndex), rma_getBlockPtr(header, blockIndex), header->blockSize);
+
+            unsigned char *metaTable = rma_getMetaTable(header);
+            size_t const width = header->options.metaWidth;
+            if (metaTable) memcpy(metaTable + copyIndex * width, metaTable + blockIndex * width, width);
+
+            uint32_t *sizeTable = rma_getSizeTable(header);
+            if (sizeTable) __atomic_store_n(&sizeTable[copyIndex], sizeTable[blockIndex], __ATOMIC_RELAXED);
+
+            blockIndex = copyIndex;
+        }
+        else blockIndex = SIZE_MAX;
+    }
+    else if (blockIndex != SIZE_MAX && dedupBlocks){
+        // exclusive: its contents are about to change, so it can no longer be matched
+        if (dedupBlocks[blockIndex].hash) rma_dedupIndexRemove(header, blockIndex);
+    }
+
+    return blockIndex;
+}
+
+/**
+ * @brief Longest value a block of this pool can hold
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @return blockSize - RMA_VALUE_HEADER, or 0 for blocks too small for the length
+ */
+static size_t rma_valueRoom(struct rma_mem_header_t const *header){
+    return header->blockSize > RMA_VALUE_HEADER ? header->blockSize - RMA_VALUE_HEADER : 0;
+}
+
+/**
+ * @brief Store a value in a block as its length followed by the bytes
+ * @param header Pointer to RMA header structure (must not be NULL, pool lock held)
+ * @param blockIndex Block the value lives in
+ * @param value Value bytes (may be NULL when length is 0)
+ * @param length Value length, at most blockSize - RMA_VALUE_HEADER
+ *
+ * With options.sizeTracking the used size is recorded as for rma_allocSized().
+ */
+static void rma_writeValue(struct rma_mem_header_t *header, size_t blockIndex, void const *value, size_t length){
+    unsigned char *block = rma_getBlockPtr(header, blockIndex);
+    uint32_t const stored = (uint32_t)length;
+
+    memcpy(block, &stored, sizeof(stored));
+    if (length > 0) memcpy(block + RMA_VALUE_HEADER, value, length);
+
+    uint32_t *sizeTable = rma_getSizeTable(header);
+    if (sizeTable) __atomic_store_n(&sizeTable[blockIndex], (uint32_t)(RMA_VALUE_HEADER + length), __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Run an allocation step with the probes and stats page sample every allocation gets
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param size Bytes reported by the alloc_done probe
+ * @param step Allocation proper, called with the pool lock held
+ * @param context Arguments passed through to step
+ * @return Handle returned by step
+ *
+ * Every public allocation function goes through here, so the alloc_start
+ * and alloc_done probes and the latency histogram of a published pool
+ * cover all of them. The sample is added before the lock is dropped, so
+ * rma_unpublishStats() cannot unmap the page underneath it.
+ */
+static rma_handle_t rma_allocTimed(struct rma_mem_header_t *header, size_t size, rma_alloc_step_t step, void const *context){
+    // published pools record how long every call takes, the clock starts before the lock
+    uint64_t const start = __atomic_load_n(&header->statsPage, __ATOMIC_RELAXED) ? rma_monotonicNs() : 0;
+    RMA_PROBE(alloc_start, header);
+
+    struct rma_pool_guard_t guard = rma_poolLock(header);
+    rma_handle_t const handle = step(header, &guard, context);
+    rma_statsPageLatency(header, start);
+    rma_poolUnlock(guard);
+
+    RMA_PROBE(alloc_done, header, handle, size);
+
+    return handle;
+}
+
+/**
+ * @brief Allocation step of rma_alloc()
+ */
+static rma_handle_t rma_allocStep(struct rma_mem_header_t *header, struct rma_pool_guard_t *guard, void const *context){
+    (void)guard;
+    (void)context;
+    return rma_allocBlock(header, NULL);
+}
+
+/**
+ * @brief Allocation step of rma_allocSized(), context points to the requested size
+ */
+static rma_handle_t rma_allocSizedStep(struct rma_mem_header_t *header, struct rma_pool_guard_t *guard, void const *context){
+    (void)guard;
+
+    size_t blockIndex = 0;
+    rma_handle_t const handle = rma_allocBlock(header, &blockIndex);
+
+    uint32_t *sizeTable = rma_getSizeTable(header);
+    if (handle != RMA_INVALID_HANDLE && sizeTable) __atomic_store_n(&sizeTable[blockIndex], (uint32_t)*(size_t const*)context, __ATOMIC_RELAXED);
+
+    return handle;
+}
+
+/**
+ * @brief Allocation step of rma_allocValue(), context is a struct rma_value_args_t
+ */
+static rma_handle_t rma_allocValueStep(struct rma_mem_header_t *header, struct rma_pool_guard_t *guard, void const *context){
+    (void)guard;
+    struct rma_value_args_t const *args = context;
+
+    size_t blockIndex = 0;
+    rma_handle_t const handle = rma_allocBlock(header, &blockIndex);
+    if (handle != RMA_INVALID_HANDLE) rma_writeValue(header, blockIndex, args->value, args->length);
+
+    return handle;
+}
+
+/**
+ * @brief Allocation step of rma_allocWait(), context is a struct rma_wait_args_t
+ *
+ * Drops the pool lock while it sleeps on the free sequence and retakes it
+ * before returning, as rma_allocTimed() expects.
+ */
+static rma_handle_t rma_allocWaitStep(struct rma_mem_header_t *header, struct rma_pool_guard_t *guard, void const *context){
+    struct rma_wait_args_t const *args = context;
+
+    for (;;){
+        if (header->numAllocated < header->numBlocks) return rma_allocBlock(header, NULL);
+
+        // only another thread can free a block, which needs the pool lock
+        if (!header->options.threadSafe || args->timeoutMs == 0 || guard->header == NULL) return RMA_INVALID_HANDLE;
+
+        // register under the lock so a free cannot slip between the check and the wait
+        uint32_t const sequence = __atomic_load_n(&header->freeSequence, __ATOMIC_ACQUIRE);
+        __atomic_fetch_add(&header->waiters, 1, __ATOMIC_RELAXED);
+        rma_poolUnlock(*guard);
+
+        struct timespec remaining = {0};
+        int timedOut = 0;
+        if (args->timeoutMs > 0){
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            remaining.tv_sec = args->deadline.tv_sec - now.tv_sec;
+            remaining.tv_nsec = args->deadline.tv_nsec - now.tv_nsec;
+            if (remaining.tv_nsec < 0){
+                remaining.tv_sec--;
+                remaining.tv_nsec += 1000000000;
+            }
+            timedOut = remaining.tv_sec < 0;
+        }
+
+        long const result = timedOut ? -1 : rma_futex(&header->freeSequence, FUTEX_WAIT, sequence, args->timeoutMs > 0 ? &remaining : NULL);
+        int const error = errno;
+        __atomic_fetch_sub(&header->waiters, 1, __ATOMIC_RELAXED);
+
+        *guard = rma_poolLock(header);
+        if (timedOut || (result != 0 && error == ETIMEDOUT)) return RMA_INVALID_HANDLE;
+    }
+}
+
+/**
+ * @brief Allocation step of rma_allocWithTTL(), context points to the TTL in ticks
+ */
+static rma_handle_t rma_allocTtlStep(struct rma_mem_header_t *header, struct rma_pool_guard_t *guard, void const *context){
+    (void)guard;
+    uint64_t const ttl = *(uint64_t const*)context;
+
+    size_t blockIndex = 0;
+    rma_handle_t const handle = rma_allocBlock(header, &blockIndex);
+
+    // the current tick has already been processed, so the earliest expiry is the next one
+    if (handle != RMA_INVALID_HANDLE){
+        rma_getTtlTable(header)[blockIndex].expiry = header->currentTick + (ttl ? ttl : 1);
+        rma_ttlLink(header, blockIndex);
+        rma_statAdd(&header->numTimers, 1);
+    }
+
+    return handle;
+}
+
+/**
+ * @brief Allocation step of rma_allocOrEvict(), context is a struct rma_evict_args_t
+ */
+static rma_handle_t rma_allocEvictStep(struct rma_mem_header_t *header, struct rma_pool_guard_t *guard, void const *context){
+    (void)guard;
+    struct rma_evict_args_t const *args = context;
+    return rma_evictAndAlloc(header, args->onEvict, args->context);
+}
+
+/**
+ * @brief Account one free run in a statistics snapshot
+ * @param stats Snapshot being filled (must not be NULL)
+ * @param run Run length in blocks (0 is ignored)
+ */
+static void rma_statsAddRun(struct rma_stats_t *stats, size_t run){
+    if (run == 0) return;
+
+    size_t bucket = (size_t)(63 - __builtin_clzll(run));
+    if (bucket >= RMA_STATS_RUN_BUCKETS) bucket = RMA_STATS_RUN_BUCKETS - 1;
+
+    stats->runHistogram[bucket]++;
+    stats->freeRuns++;
+    if (run > stats->largestFreeRun) stats->largestFreeRun = run;
+}
+
+/**
+ * @brief Count the allocated blocks in a range of the bitmap
+ * @param bitmap Block bitmap (must not be NULL)
+ * @param start First block of the range
+ * @param end One past the last block of the range
+ * @return Number of set bits in [start, end)
+ *
+ * Loads every word once with an atomic load, so it can run without the
+ * pool lock like rma_getStats().
+ */
+static size_t rma_countAllocated(uint32_t const *bitmap, size_t start, size_t end){
+    size_t count = 0;
+
+    while (start < end){
+        size_t const word = start / 32;
+        size_t const bit = start % 32;
+        size_t const bits = end - start < 32 - bit ? end - start : 32 - bit;
+
+        uint32_t const mask = (bits == 32 ? ~0u : ((1u << bits) - 1)) << bit;
+        count += (size_t)__builtin_popcount(__atomic_load_n(&bitmap[word], __ATOMIC_RELAXED) & mask);
+        start += bits;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Find the first run of free blocks of a given length
+ * @param header Pointer to RMA header structure (must not be NULL)
+ * @param count Number of contiguous free blocks wanted (must be > 0)
+ * @return Index of the first block of the run, or SIZE_MAX if none is long enough
+ */
+static size_t rma_findFreeRun(struct rma_mem_header_t *header, size_t count){
+    uint32_t *bitmap = rma_getBitmap(header);
+    size_t runStart = 0;
+
+    for (size_t blockIndex = 0; blockIndex < header->numBlocks; blockIndex++){
+        if (rma_isBlockAllocated(bitmap, blockIndex)) runStart = blockIndex + 1;
+        else if (blockIndex + 1 - runStart == count) return runStart;
+    }
+
+    return SIZE_MAX;
+}
+
+/**
+ * @brief Hand the block run of a child pool back to its parent
+ * @param child Child pool made by rma_createChild() (must not be NULL)
+ *
+ * The child header lives inside the run, so everything needed is read
+ * before the first block is released.
+ */
+static void rma_returnChildRun(struct rma_mem_header_t *child){
+    struct rma_mem_header_t *parent = child->parent;
+    rma_handle_t const handle = child->parentHandle;
+    size_t const first = child->parentFirstBlock;
+    size_t const count = child->parentBlocks;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(parent);
+
+    for (size_t blockIndex = first; blockIndex < first + count; blockIndex++){
+        if (rma_isResolvedTo(parent, handle, blockIndex)) rma_releaseBlock(parent, blockIndex);
+    }
+    parent->numChildren--;
+    parent->childTags &= ~(1u << child->poolTag);
+
+    rma_poolUnlock(guard);
+}
+
+/**
+ * @brief Resize a pool (the body of rma_resize())
+ * @param header Pointer to initialized RMA header (must not be NULL)
+ * @param newTotalSize New total pool size in bytes
+ * @return Pointer to the resized header (may differ from the input), or NULL on failure
+ */
+static struct rma_mem_header_t* rma_resizePool(struct rma_mem_header_t *header, size_t newTotalSize){
+    size_t const oldTotalSize = header->totalSize;
+
+    struct rma_layout_t layout;
+    if (!rma_computeLayout(newTotalSize, header->blockSize, &header->options, &layout)) return NULL;
+    if (newTotalSize == header->totalSize) return header;
+
+    // dedup hash tables are sized by the block count and have to be rebuilt when that changes
+    int const rehash = header->dedupBlocksOffset && layout.dedupCapacity != header->dedupCapacity;
+    struct rma_dedup_alias_t *aliases = NULL;
+    if (rehash && header->numAliases > 0){
+        if (header->numAliases > layout.dedupCapacity * RMA_DEDUP_MAX_LOAD / 100) return NULL;
+
+        aliases = malloc(header->numAliases * sizeof(*aliases));
+        if (aliases == NULL) return NULL;
+
+        struct rma_dedup_alias_t const *table = rma_getDedupAliases(header);
+        for (size_t slot = 0, count = 0; slot < header->dedupCapacity; slot++){
+            if (table[slot].alias != 0) aliases[count++] = table[slot];
+        }
+    }
+
+    struct rma_mem_header_t *resized = header;
+
+    if (newTotalSize > header->totalSize){
+        // grow the memory first, then spread the sections out
+        resized = rma_resizeBacking(header, newTotalSize, 1);
+        if (resized == NULL){
+            free(aliases);
+            return NULL;
+        }
+
+        rma_relocateSections(resized, &layout);
+        if (rehash) rma_dedupRebuild(resized, aliases);
+    }
+    else {
+        // every block beyond the new end must be free
+        if (rma_findNextBlock(rma_getBitmap(header), layout.numBlocks, header->numBlocks, 1) != header->numBlocks){
+            free(aliases);
+            return NULL;
+        }
+
+        // pack the sections down first, then give the tail back
+        rma_relocateSections(header, &layout);
+        if (rehash) rma_dedupRebuild(header, aliases);
+        header->totalSize = newTotalSize;
+
+        resized = rma_resizeBacking(header, newTotalSize, 0);
+        if (resized == NULL) resized = header; // still valid, just not trimmed
+    }
+
+    free(aliases);
+    resized->totalSize = newTotalSize;
+
+    // open transactions on this thread must follow the pool to its new address
+    if (resized != header){
+        for (size_t i = 0; i < rma_txLog.count; i++){
+            if (rma_txLog.entries[i].header == header) rma_txLog.entries[i].header = resized;
+        }
+    }
+
+    if (resized->statsPage) rma_statsPageUpdate(resized, 0, 0, 1);
+    RMA_PROBE(resize, header, resized, oldTotalSize, newTotalSize);
+
+    return resized;
+}
+
+/**
+ * @brief Initialize the header and clear the metadata sections of a new pool
+ * @param memPool Start of the pool memory
+ * @param totalSize Pool size in bytes
+ * @param blockSize Block size in bytes
+ * @param options Pool options (must not be NULL)
+ * @param layout Layout computed for totalSize, blockSize and options
+ * @param backing RMA_BACKING_* the memory came from
+ * @param mappedSize Bytes reserved from the backing store
+ * @param mapGranularity Page size of the backing mapping (1 for malloc and external memory)
+ * @return The initialized header at memPool
+ */
+static struct rma_mem_header_t* rma_initHeader(void *memPool, size_t totalSize, size_t blockSize, struct rma_options_t const *options,
+                                               struct rma_layout_t const *layout, int backing, size_t mappedSize, size_t mapGranularity){
+    // initialize the header at the start of the pool
+    struct rma_mem_header_t *header = (struct rma_mem_header_t*)memPool;
+
+    // initialize info of the struct
+    header->totalSize = totalSize;
+    header->usedSize = sizeof(struct rma_mem_header_t);
+    header->blockSize = blockSize;
+    header->blockStride = layout->blockStride;
+    header->numAllocated = 0;
+    header->nextHandle = 1; // Handles start at 1 (0 = invalid)
+
+    // Initialize offsets
+    header->bitmapOffset = layout->bitmapOffset;
+    header->pinnedBitmapOffset = layout->pinnedBitmapOffset;
+    header->handleTableOffset = layout->handleTableOffset;
+    header->dataOffset = layout->dataOffset;
+    header->epochTableOffset = layout->epochTableOffset;
+    header->sizeTableOffset = layout->sizeTableOffset;
+    header->metaTableOffset = layout->metaTableOffset;
+    header->ttlTableOffset = layout->ttlTableOffset;
+    header->timerWheelOffset = layout->timerWheelOffset;
+    header->refBitmapOffset = layout->refBitmapOffset;
+    header->lockTableOffset = layout->lockTableOffset;
+    header->dedupBlocksOffset = layout->dedupBlocksOffset;
+    header->dedupIndexOffset = layout->dedupIndexOffset;
+    header->dedupAliasOffset = layout->dedupAliasOffset;
+    header->dedupCapacity = layout->dedupCapacity;
+    header->numIndexed = 0;
+    header->numAliases = 0;
+    header->registered = 0;
+    header->statsPage = NULL;
+    header->poolTag = 0;
+    header->childTags = 0;
+    header->numChildren = 0;
+    header->parent = NULL;
+    header->parentHandle = RMA_INVALID_HANDLE;
+    header->parentFirstBlock = 0;
+    header->parentBlocks = 0;
+    header->numBlocks = layout->numBlocks;
+    header->clockHand = 0;
+
+    // nobody holds the lock or waits for blocks yet
+    header->lockWord = 0;
+    header->freeSequence = 0;
+    header->waiters = 0;
+    header->eventFd = -1;
+
+    // the TTL clock starts at tick 0
+    header->currentTick = 0;
+    header->numTimers = 0;
+
+    // no epoch is active until rma_beginEpoch()
+    header->currentEpoch = 0;
+    header->nextEpoch = 1;
+
+    // remember how the pool was built
+    header->options = *options;
+    header->backing = backing;
+    header->mappedSize = mappedSize;
+    header->mapGranularity = mapGranularity;
+
+    return header;
+}
+
+/**
+ * @brief Clear the bitmap, handle table and side arrays of a pool
+ * @param header Pointer to RMA header structure (must not be NULL)
+ *
+ * Whole words are cleared, so word-level scans never see garbage. Block
+ * data is left alone.
+ */
+static void rma_clearMetadata(struct rma_mem_header_t *header){
+    memset((char*)header + header->bitmapOffset, 0, header->dataOffset - header->bitmapOffset);
+}
+
+/**
+ * @brief Return the memory of a malloc- or mmap-backed pool
+ * @param header Pointer to RMA header structure (must not be NULL)
+ */
+static void rma_releaseBacking(struct rma_mem_header_t *header){
+    if (header->backing == RMA_BACKING_MMAP){
+        munmap(header, header->mappedSize);
+    }
+    else {
+        free(header);
+    }
+}
+
+/**
+ * @brief Park a destroyed pool in the warm pool cache
+ * @param header Pool being destroyed (malloc or mmap backed)
+ * @return 1 if the pool was parked, 0 if the cache is full or over its cap
+ */
+static int rma_poolCachePark(struct rma_mem_header_t *header){
+    pthread_mutex_lock(&rma_poolCache.lock);
+
+    int const fits = rma_poolCache.count < RMA_POOL_CACHE_MAX && header->mappedSize <= rma_poolCache.maxBytes - rma_poolCache.cachedBytes;
+    if (fits){
+        rma_clearMetadata(header);
+        rma_poolCache.pools[rma_poolCache.count++] = header;
+        rma_poolCache.cachedBytes += header->mappedSize;
+    }
+
+    pthread_mutex_unlock(&rma_poolCache.lock);
+
+    return fits;
+}
+
+/**
+ * @brief Take a parked pool matching a requested shape out of the cache
+ * @param totalSize Requested pool size in bytes
+ * @param blockSize Requested block size in bytes
+ * @param options Requested options (must not be NULL)
+ * @return Parked pool with cleared metadata, or NULL if none matches
+ *
+ * The layout is rebuilt by rma_initHeader(), so only the size and the way
+ * the memory was obtained (backing, huge pages, alignment) have to match.
+ */
+static struct rma_mem_header_t* rma_poolCacheTake(size_t totalSize, size_t blockSize, struct rma_options_t const *options){
+    int const backing = options->backing == RMA_BACKING_MMAP || options->hugePages ? RMA_BACKING_MMAP : RMA_BACKING_MALLOC;
+    struct rma_mem_header_t *taken = NULL;
+
+    pthread_mutex_lock(&rma_poolCache.lock);
+
+    for (size_t i = 0; i < rma_poolCache.count; i++){
+        struct rma_mem_header_t *pool = rma_poolCache.pools[i];
+        if (pool->totalSize != totalSize || pool->blockSize != blockSize || pool->backing != backing) continue;
+        if (!pool->options.hugePages != !options->hugePages || pool->options.alignment != options->alignment) continue;
+
+        taken = pool;
+        rma_poolCache.pools[i] = rma_poolCache.pools[--rma_poolCache.count];
+        rma_poolCache.cachedBytes -= pool->mappedSize;
+        break;
+    }
+
+    pthread_mutex_unlock(&rma_poolCache.lock);
+
+    return taken;
+}
+
+/**
+ * @brief Release parked pools until the cache holds at most keepBytes
+ * @param keepBytes Bytes the cache may keep
+ * @return Number of pools released
+ *
+ * Called with rma_poolCache.lock held.
+ */
+static size_t rma_poolCacheShrink(size_t keepBytes){
+    size_t released = 0;
+
+    while (rma_poolCache.cachedBytes > keepBytes){
+        struct rma_mem_header_t *pool = rma_poolCache.pools[--rma_poolCache.count];
+        rma_poolCache.cachedBytes -= pool->mappedSize;
+        rma_releaseBacking(pool);
+        released++;
+    }
+
+    return released;
+}
+
+/**
+ * FUNCTION DEFINITIONS
+ */
+
+int rma_computeLayout(size_t totalSize, size_t blockSize, struct rma_options_t const *options, struct rma_layout_t *layout){
+    if (layout == NULL || blockSize == 0) return 0;
+
+    // alignment must be a power of two that evenly divides the block size
+    size_t const alignment = options ? options->alignment : 0;
+    if (alignment != 0 && ((alignment & (alignment - 1)) != 0 || blockSize % alignment != 0)) return 0;
+    if (options && options->metaWidth > RMA_META_MAX_WIDTH) return 0;
+    if (options && options->lockStripes && (options->lockStripes > RMA_LOCK_STRIPES_MAX || (options->lockStripes & (options->lockStripes - 1)))) return 0;
+
+    size_t const headerSize = sizeof(struct rma_mem_header_t);
+    if (totalSize <= headerSize) return 0;
+
+    // colored pools pad every block by one step, so consecutive blocks start on different cache sets
+    layout->blockStride = blockSize;
+    if (options && options->coloring) layout->blockStride += alignment > RMA_COLOR_STEP ? alignment : RMA_COLOR_STEP;
+
+    // Aproximate block sizing
+    size_t const maxPossibleBlocks = (totalSize - headerSize) / layout->blockStride;
+
+    // Calculate layout offsets
+    size_t const bitmapSize = (maxPossibleBlocks + 31) / 32 * sizeof(uint32_t);
+    size_t const handleTableSize = maxPossibleBlocks * sizeof(uint32_t);
+
+    size_t offset = headerSize;
+    layout->bitmapOffset = offset;
+    offset += bitmapSize;
+    layout->pinnedBitmapOffset = offset;
+    offset += bitmapSize;
+    layout->handleTableOffset = offset;
+    offset += handleTableSize;
+
+    // optional per-block side arrays, sized in whole bitmap words so sweeps can read 32 entries at a time
+    size_t const paddedBlocks = (maxPossibleBlocks + 31) / 32 * 32;
+
+    layout->epochTableOffset = 0;
+    if (options && options->epochTags){
+        layout->epochTableOffset = offset;
+        offset += paddedBlocks * sizeof(uint32_t);
+    }
+
+    layout->sizeTableOffset = 0;
+    if (options && options->sizeTracking){
+        layout->sizeTableOffset = offset;
+        offset += paddedBlocks * sizeof(uint32_t);
+    }
+
+    layout->metaTableOffset = 0;
+    if (options && options->metaWidth){
+        layout->metaTableOffset = offset;
+        offset += paddedBlocks * options->metaWidth;
+    }
+
+    layout->ttlTableOffset = 0;
+    layout->timerWheelOffset = 0;
+    if (options && options->ttl){
+        offset = (offset + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+        layout->ttlTableOffset = offset;
+        offset += paddedBlocks * sizeof(struct rma_ttl_entry_t);
+        layout->timerWheelOffset = offset;
+        offset += sizeof(struct rma_timer_wheel_t);
+    }
+
+    layout->refBitmapOffset = 0;
+    if (options && options->eviction){
+        layout->refBitmapOffset = offset;
+        offset += bitmapSize;
+    }
+
+    layout->dedupBlocksOffset = 0;
+    layout->dedupIndexOffset = 0;
+    layout->dedupAliasOffset = 0;
+    layout->dedupCapacity = 0;
+    if (options && options->dedup){
+        // hash tables at most half full of blocks, so probe chains stay short
+        size_t capacity = 64;
+        while (capacity < 2 * paddedBlocks) capacity *= 2;
+
+        offset = (offset + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+        layout->dedupBlocksOffset = offset;
+        offset += paddedBlocks * sizeof(struct rma_dedup_block_t);
+        layout->dedupIndexOffset = offset;
+        offset += capacity * sizeof(struct rma_dedup_entry_t);
+        layout->dedupAliasOffset = offset;
+        offset += capacity * sizeof(struct rma_dedup_alias_t);
+        layout->dedupCapacity = capacity;
+    }
+
+    layout->lockTableOffset = 0;
+    if (options && options->lockStripes){
+        offset = (offset + 63) & ~(size_t)63;
+        layout->lockTableOffset = offset;
+        offset += options->lockStripes * sizeof(struct rma_lock_stripe_t);
+    }
+
+    layout->dataOffset = offset;
+    if (alignment != 0) layout->dataOffset = (layout->dataOffset + alignment - 1) & ~(alignment - 1);
+
+    // the real block count is whatever fits behind the metadata
+    if (layout->dataOffset >= totalSize) return 0;
+    layout->numBlocks = (totalSize - layout->dataOffset) / layout->blockStride;
+
+    return layout->numBlocks > 0;
+}
+
+size_t rma_poolSizeForBlocks(size_t numBlocks, size_t blockSize, struct rma_options_t const *options){
+    if (numBlocks == 0 || blockSize == 0) return 0;
+    if (numBlocks > (SIZE_MAX - sizeof(struct rma_mem_header_t)) / blockSize) return 0;
+
+    // reject invalid options up front instead of looping forever; the probe
+    // doubles so fixed-size sections (lock stripes) can't fail it
+    struct rma_layout_t layout = {0};
+    size_t probeSize = sizeof(struct rma_mem_header_t) + 64 * blockSize;
+    while (!rma_computeLayout(probeSize, blockSize, options, &layout)){
+        if (probeSize > SIZE_MAX / 4) return 0;
+        probeSize *= 2;
+    }
+
+    // start from the metadata-free estimate and grow until the layout fits
+    size_t totalSize = sizeof(struct rma_mem_header_t) + numBlocks * blockSize;
+
+    while (!rma_computeLayout(totalSize, blockSize, options, &layout) || layout.numBlocks < numBlocks){
+        if (totalSize > SIZE_MAX - blockSize) return 0;
+        totalSize += blockSize;
+    }
+
+    return totalSize;
+}
+
+void* rma_memHeaderInit(size_t totalSize, size_t blockSize){
+    return rma_memHeaderInitEx(totalSize, blockSize, NULL);
+}
+
+void* rma_memHeaderInitEx(size_t totalSize, size_t blockSize, struct rma_options_t const *options){
+    struct rma_options_t const defaults = {0};
+    if (options == NULL) options = &defaults;
+
+    struct rma_layout_t layout;
+    if (!rma_computeLayout(totalSize, blockSize, options, &layout)) return NULL;
+
+    // a parked pool of the same shape skips the allocation and the page faults
+    struct rma_mem_header_t *cached = rma_poolCacheTake(totalSize, blockSize, options);
+    if (cached != NULL){
+        uint32_t const nextHandle = cached->nextHandle;
+        size_t const clearedEnd = cached->dataOffset;
+
+        struct rma_mem_header_t *header = rma_initHeader(cached, totalSize, blockSize, options, &layout, cached->backing, cached->mappedSize, cached->mapGranularity);
+        header->nextHandle = nextHandle != 0 ? nextHandle : 1;
+
+        // only metadata reaching into the old pool's blocks still needs clearing
+        if (header->dataOffset > clearedEnd) rma_clearMetadata(header);
+        return header;
+    }
+
+    size_t mappedSize = 0, mapGranularity = 0;
+    int backing = 0;
+    void *memPool = rma_acquireBacking(totalSize, options, &backing, &mappedSize, &mapGranularity);
+    if (memPool == NULL) return NULL;
+
+    struct rma_mem_header_t *header = rma_initHeader(memPool, totalSize, blockSize, options, &layout, backing, mappedSize, mapGranularity);
+    rma_clearMetadata(header);
+    return header;
+}
+
+void* rma_initInPlace(void *mem, size_t size, size_t blockSize, struct rma_options_t const *options){
+    struct rma_options_t const defaults = {0};
+    if (options == NULL) options = &defaults;
+    if (mem == NULL) return NULL;
+
+    // the header and side tables need natural alignment, blocks are aligned relative to mem
+    size_t const alignment = options->alignment > _Alignof(max_align_t) ? options->alignment : _Alignof(max_align_t);
+    if ((uintptr_t)mem & (alignment - 1)) return NULL;
+
+    struct rma_layout_t layout;
+    if (!rma_computeLayout(size, blockSize, options, &layout)) return NULL;
+
+    struct rma_mem_header_t *header = rma_initHeader(mem, size, blockSize, options, &layout, RMA_BACKING_EXTERNAL, size, 1);
+    rma_clearMetadata(header);
+    return header;
+}
+
+struct rma_mem_header_t* rma_createChild(struct rma_mem_header_t *parent, size_t size, size_t blockSize){
+    if (parent == NULL || size == 0 || blockSize == 0) return NULL;
+
+    struct rma_options_t const options = { .alignment = parent->options.alignment, .threadSafe = parent->options.threadSafe };
+    size_t const alignment = options.alignment > _Alignof(max_align_t) ? options.alignment : _Alignof(max_align_t);
+
+    // the child starts at the first aligned address of the run, so reserve room for the skip
+    if (size > SIZE_MAX - alignment) return NULL;
+    size_t const needed = size + alignment - 1;
+
+    // the run ends with the last block's payload, stride padding in between is part of the run
+    size_t const runBlocks = needed <= parent->blockSize ? 1 : 2 + (needed - parent->blockSize - 1) / parent->blockStride;
+    size_t const runSize = (runBlocks - 1) * parent->blockStride + parent->blockSize;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(parent);
+
+    // the child's tag must differ from every ancestor's and every live sibling's (RMA_INLINE_TAG is never a pool's)
+    uint32_t takenTags = parent->childTags | 1u << RMA_INLINE_TAG;
+    for (struct rma_mem_header_t const *ancestor = parent; ancestor != NULL; ancestor = ancestor->parent){
+        takenTags |= 1u << ancestor->poolTag;
+    }
+    uint32_t const freeTags = ~takenTags & ((1u << RMA_HANDLE_TAGS) - 1);
+
+    size_t const first = freeTags ? rma_findFreeRun(parent, runBlocks) : SIZE_MAX;
+    uint16_t const salt = first != SIZE_MAX && parent->nextHandle != 0 ? rma_generateSalt(parent) : 0;
+
+    struct rma_mem_header_t *child = NULL;
+    if (salt != 0){
+        uintptr_t const runStart = (uintptr_t)rma_getBlockPtr(parent, first);
+        size_t const skip = (alignment - runStart % alignment) % alignment;
+        child = rma_initInPlace((void*)(runStart + skip), runSize - skip, blockSize, &options);
+    }
+
+    if (child != NULL){
+        uint32_t const tag = (uint32_t)__builtin_ctz(freeTags);
+
+        // the whole run is one parent allocation, pinned so nothing moves or reclaims it; its
+        // handle carries the child's tag, so the parent rejects it (-3) in rma_free() and friends
+        rma_handle_t const handle = ((uint32_t)salt << 16) | (tag << RMA_HANDLE_TAG_SHIFT) |
+                                    (parent->nextHandle & ((1u << RMA_HANDLE_TAG_SHIFT) - 1));
+        parent->nextHandle++;
+
+        uint32_t *epochTable = rma_getEpochTable(parent);
+        for (size_t blockIndex = first; blockIndex < first + runBlocks; blockIndex++){
+            rma_claimBlock(parent, blockIndex, handle);
+            rma_markBlockAllocated(rma_getPinnedBitmap(parent), blockIndex);
+            if (epochTable) epochTable[blockIndex] = 0;
+        }
+
+        child->poolTag = tag;
+        child->parent = parent;
+        child->parentHandle = handle;
+        child->parentFirstBlock = first;
+        child->parentBlocks = runBlocks;
+        parent->numChildren++;
+        parent->childTags |= 1u << tag;
+    }
+
+    rma_poolUnlock(guard);
+
+    return child;
+}
+
+void rma_destroy(struct rma_mem_header_t *header){
+    if (header == NULL) return;
+
+    // children live inside this pool's blocks, destroying it would pull the memory out from under them
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+    size_t const numChildren = header->numChildren;
+    rma_poolUnlock(guard);
+    if (numChildren > 0) return;
+
+    if (header->registered) rma_unregisterPool(header);
+    if (header->statsPage) rma_unpublishStats(header);
+
+    if (header->eventFd >= 0) close(header->eventFd);
+
+    if (header->backing == RMA_BACKING_EXTERNAL){
+        // in-place memory belongs to the caller, a child's run to its parent
+        if (header->parent != NULL) rma_returnChildRun(header);
+        return;
+    }
+
+    if (!rma_poolCachePark(header)) rma_releaseBacking(header);
+}
+
+size_t rma_setPoolCacheLimit(size_t maxBytes){
+    pthread_mutex_lock(&rma_poolCache.lock);
+
+    size_t const previous = rma_poolCache.maxBytes;
+    rma_poolCache.maxBytes = maxBytes;
+    rma_poolCacheShrink(maxBytes);
+
+    pthread_mutex_unlock(&rma_poolCache.lock);
+
+    return previous;
+}
+
+size_t rma_drainPoolCache(void){
+    pthread_mutex_lock(&rma_poolCache.lock);
+    size_t const released = rma_poolCacheShrink(0);
+    pthread_mutex_unlock(&rma_poolCache.lock);
+
+    return released;
+}
+
+rma_handle_t rma_alloc(struct rma_mem_header_t *header){
+    if (header == NULL) return RMA_INVALID_HANDLE;
+
+    return rma_allocTimed(header, header->blockSize, rma_allocStep, NULL);
+}
+
+rma_handle_t rma_allocSized(struct rma_mem_header_t *header, size_t size){
+    if (header == NULL || size == 0 || size > header->blockSize) return RMA_INVALID_HANDLE;
+
+    return rma_allocTimed(header, size, rma_allocSizedStep, &size);
+}
+
+size_t rma_getSize(struct rma_mem_header_t *header, rma_handle_t handle){
+    if (header == NULL || header->sizeTableOffset == 0 || handle == RMA_INVALID_HANDLE) return 0;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+    size_t const blockIndex = rma_findBlockByHandle(header, handle);
+    size_t const size = blockIndex != SIZE_MAX ? rma_getSizeTable(header)[blockIndex] : 0;
+    rma_poolUnlock(guard);
+
+    return size;
+}
+
+rma_handle_t rma_allocValue(struct rma_mem_header_t *header, void const *value, size_t length){
+    if (header == NULL || (value == NULL && length > 0)) return RMA_INVALID_HANDLE;
+    if (length <= RMA_INLINE_MAX) return rma_encodeInline(value, length);
+    if (length > rma_valueRoom(header)) return RMA_INVALID_HANDLE;
+
+    struct rma_value_args_t const args = { value, length };
+    return rma_allocTimed(header, RMA_VALUE_HEADER + length, rma_allocValueStep, &args);
+}
+
+size_t rma_getValue(struct rma_mem_header_t *header, rma_handle_t handle, void *out, size_t capacity){
+    if (header == NULL || handle == RMA_INVALID_HANDLE || (out == NULL && capacity > 0)) return 0;
+
+    if (rma_isInline(handle)){
+        unsigned char bytes[RMA_INLINE_MAX];
+        size_t const length = rma_decodeInline(handle, bytes);
+        memcpy(out, bytes, length < capacity ? length : capacity);
+        return length;
+    }
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+
+    size_t length = 0;
+    size_t const blockIndex = rma_findBlockByHandle(header, handle);
+    size_t const room = rma_valueRoom(header);
+    if (blockIndex != SIZE_MAX && room > 0){
+        unsigned char const *block = rma_getBlockPtr(header, blockIndex);
+        uint32_t stored;
+        memcpy(&stored, block, sizeof(stored));
+
+        // a block that never held a value has no meaningful length
+        length = stored < room ? stored : room;
+        memcpy(out, block + RMA_VALUE_HEADER, length < capacity ? length : capacity);
+    }
+
+    rma_poolUnlock(guard);
+
+    return length;
+}
+
+rma_handle_t rma_setValue(struct rma_mem_header_t *header, rma_handle_t handle, void const *value, size_t length){
+    if (header == NULL || (value == NULL && length > 0)) return RMA_INVALID_HANDLE;
+
+    // inline values are re-encoded, and only get a block once they outgrow the handle
+    if (handle == RMA_INVALID_HANDLE || rma_isInline(handle)) return rma_allocValue(header, value, length);
+    if (length > rma_valueRoom(header)) return RMA_INVALID_HANDLE;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+
+    // shared blocks are copied and exclusive ones unindexed, as for rma_getPtrMut()
+    size_t const blockIndex = rma_blockForWrite(header, handle);
+    if (blockIndex != SIZE_MAX) rma_writeValue(header, blockIndex, value, length);
+
+    rma_poolUnlock(guard);
+
+    return blockIndex != SIZE_MAX ? handle : RMA_INVALID_HANDLE;
+}
+
+int rma_isInline(rma_handle_t handle){
+    return rma_handleTag(handle) == RMA_INLINE_TAG;
+}
+
+rma_handle_t rma_allocWait(struct rma_mem_header_t *header, int timeoutMs){
+    if (header == NULL) return RMA_INVALID_HANDLE;
+
+    struct rma_wait_args_t args = { .timeoutMs = timeoutMs };
+    if (timeoutMs > 0){
+        clock_gettime(CLOCK_MONOTONIC, &args.deadline);
+        args.deadline.tv_sec += timeoutMs / 1000;
+        args.deadline.tv_nsec += (long)(timeoutMs % 1000) * 1000000;
+        if (args.deadline.tv_nsec >= 1000000000){
+            args.deadline.tv_sec++;
+            args.deadline.tv_nsec -= 1000000000;
+        }
+    }
+
+    return rma_allocTimed(header, header->blockSize, rma_allocWaitStep, &args);
+}
+
+int rma_eventFd(struct rma_mem_header_t *header){
+    if (header == NULL) return -1;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+    if (header->eventFd < 0) header->eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    int const eventFd = header->eventFd;
+    rma_poolUnlock(guard);
+
+    return eventFd;
+}
+
+int rma_free(struct rma_mem_header_t *header, rma_handle_t handle){
+    // an inline value owns no block
+    if (rma_isInline(handle)) return header != NULL;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+
+    // Validate the handle
+    int const validity = rma_isValidHandle(header, handle);
+    if (validity > 0){
+        // Find the block
+        size_t const blockIndex = rma_findBlockByHandle(header, handle);
+
+        // Update all the data structures (a shared block stays with its other handles)
+        if (!rma_dedupDetach(header, blockIndex, handle)) rma_releaseBlock(header, blockIndex);
+
+        if (rma_txLog.depth > 0) rma_txForget(header, handle);
+    }
+
+    rma_poolUnlock(guard);
+
+    RMA_PROBE(free, header, handle, validity > 0 ? 1 : validity);
+
+    return validity > 0 ? 1 : validity; // invalid handles pass through the error code
+}
+
+void* rma_getPtr(struct rma_mem_header_t *header, rma_handle_t handle){
+    // validate header and handle
+    if (header == NULL) return NULL;
+
+    // an inline value has no block, rma_getValue() decodes it
+    if (rma_isInline(handle)) return NULL;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+    void *block = NULL;
+
+    int const validity = rma_isValidHandle(header, handle);
+    if (validity > 0){
+        // get the block index
+        size_t const blockIndex = rma_findBlockByHandle(header, handle);
+
+        // get the memory adress using my static helper function
+        if (blockIndex != SIZE_MAX){
+            rma_markReferenced(header, blockIndex);
+            block = rma_getBlockPtr(header, blockIndex);
+        }
+    }
+
+    rma_poolUnlock(guard);
+
+    if (block == NULL) RMA_PROBE(getptr_fail, header, handle, validity);
+
+    return block;
+}
+
+void* rma_getPtrMut(struct rma_mem_header_t *header, rma_handle_t handle){
+    // an inline value has no block to write through, rma_setValue() replaces it
+    if (header == NULL || rma_isInline(handle)) return NULL;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+
+    size_t const blockIndex = rma_blockForWrite(header, handle);
+
+    void *block = NULL;
+    if (blockIndex != SIZE_MAX){
+        rma_markReferenced(header, blockIndex);
+        block = rma_getBlockPtr(header, blockIndex);
+    }
+
+    rma_poolUnlock(guard);
+
+    return block;
+}
+
+int rma_dedupBlock(struct rma_mem_header_t *header, rma_handle_t handle){
+    if (header == NULL || header->dedupBlocksOffset == 0) return -1;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+    int result = -1;
+
+    size_t const blockIndex = rma_isValidHandle(header, handle) > 0 ? rma_findBlockByHandle(header, handle) : SIZE_MAX;
+    struct rma_dedup_block_t *blocks = rma_getDedupBlocks(header);
+    uint32_t const *handleTable = rma_getHandleTable(header);
+
+    if (blockIndex == SIZE_MAX) result = -1;
+    else if (blocks[blockIndex].shares > 0 || handleTable[blockIndex] != handle) result = 1;
+    else if (rma_isBlockAllocated(rma_getPinnedBitmap(header), blockIndex)) result = -2;
+    else {
+        // the contents may have changed since the block was indexed
+        rma_dedupIndexRemove(header, blockIndex);
+
+        void const *contents = rma_getBlockPtr(header, blockIndex);
+        uint64_t const hash = rma_hashBlock(contents, header->blockSize);
+        int const aliasRoom = header->numAliases < header->dedupCapacity * RMA_DEDUP_MAX_LOAD / 100;
+
+        struct rma_dedup_entry_t const *index = rma_getDedupIndex(header);
+        size_t const mask = header->dedupCapacity - 1;
+        size_t match = SIZE_MAX;
+        rma_handle_t owner = RMA_INVALID_HANDLE;
+
+        // equal hashes are only candidates, the bytes decide
+        for (size_t slot = hash & mask, probes = 0; aliasRoom && probes <= mask && index[slot].owner != 0; slot = (slot + 1) & mask, probes++){
+            if (index[slot].hash != hash) continue;
+
+            size_t const candidate = rma_findBlockByHandle(header, index[slot].owner);
+            if (candidate == SIZE_MAX || candidate == blockIndex) continue;
+            if (memcmp(rma_getBlockPtr(header, candidate), contents, header->blockSize) != 0) continue;
+
+            match = candidate;
+            owner = index[slot].owner;
+            break;
+        }
+
+        if (match != SIZE_MAX){
+            rma_releaseBlock(header, blockIndex);
+            rma_dedupAliasInsert(header, handle, owner);
+            blocks[match].shares++;
+            rma_statAdd(&header->numAliases, 1);
+            result = 1;
+        }
+        else {
+            rma_dedupIndexInsert(header, hash, handle);
+            blocks[blockIndex].hash = hash;
+            rma_statAdd(&header->numIndexed, 1);
+            result = 0;
+        }
+    }
+
+    rma_poolUnlock(guard);
+
+    return result;
+}
+
+int rma_prefetch(struct rma_mem_header_t *header, rma_handle_t handle, int rw, int locality){
+    if (header == NULL || handle == RMA_INVALID_HANDLE) return 0;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+    size_t const blockIndex = rma_findBlockByHandle(header, handle);
+    void const *block = blockIndex != SIZE_MAX ? rma_getBlockPtr(header, blockIndex) : NULL;
+    rma_poolUnlock(guard);
+
+    if (block == NULL) return 0;
+
+    rma_prefetchBlock(block, header->blockSize, rw, locality);
+    return 1;
+}
+
+size_t rma_prefetchBatch(struct rma_mem_header_t *header, rma_handle_t const *handles, size_t count, void **ptrs, int rw, int locality){
+    if (header == NULL || handles == NULL) return 0;
+
+    // resolve in chunks so the working arrays stay on the stack
+    enum { chunkSize = 64 };
+    uint16_t salts[chunkSize];
+    size_t indices[chunkSize];
+    size_t found = 0;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+
+    for (size_t first = 0; first < count; first += chunkSize){
+        size_t const chunk = count - first < chunkSize ? count - first : chunkSize;
+
+        for (size_t i = 0; i < chunk; i++) salts[i] = (uint16_t)(handles[first + i] >> 16);
+        qsort(salts, chunk, sizeof(uint16_t), rma_compareSalts);
+
+        rma_findBlocksBySalts(header, salts, chunk, indices);
+
+        // map results back to the caller's order and prefetch
+        for (size_t i = 0; i < chunk; i++){
+            uint16_t const salt = (uint16_t)(handles[first + i] >> 16);
+            void *block = NULL;
+
+            if (handles[first + i] != RMA_INVALID_HANDLE){
+                uint16_t const *match = bsearch(&salt, salts, chunk, sizeof(uint16_t), rma_compareSalts);
+                size_t const blockIndex = match ? indices[match - salts] : SIZE_MAX;
+                size_t resolved = blockIndex != SIZE_MAX && rma_getHandleTable(header)[blockIndex] == handles[first + i] ? blockIndex : SIZE_MAX;
+
+                // deduplicated handles are not in the handle table
+                if (resolved == SIZE_MAX && header->numAliases > 0) resolved = rma_findBlockByHandle(header, handles[first + i]);
+
+                // a salt match alone does not count, only a resolved handle
+                if (resolved != SIZE_MAX){
+                    found++;
+                    block = rma_getBlockPtr(header, resolved);
+                    rma_markReferenced(header, resolved);
+                    rma_prefetchBlock(block, header->blockSize, rw, locality);
+                }
+            }
+
+            if (ptrs) ptrs[first + i] = block;
+        }
+    }
 
-    // store the handle
-    handleTable[freeBlockIndex] = salt;
+    rma_poolUnlock(guard);
 
-    header->numAllocated++;
-    header->nextHandle++;
-    header->usedSize += header->blockSize;
+    return found;
+}
 
-    rma_markBlockAllocated(bitmap, freeBlockIndex);
+void* rma_getPtrPrefetchNext(struct rma_mem_header_t *header, rma_handle_t handle, rma_handle_t nextHandle){
+    if (header == NULL || handle == RMA_INVALID_HANDLE) return NULL;
 
-    return handle;
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+
+    // in a pipelined traversal the handle was the previous call's nextHandle
+    size_t blockIndex = SIZE_MAX;
+    if (rma_prefetchNextCache.header == header && rma_prefetchNextCache.handle == handle &&
+        rma_isResolvedTo(header, handle, rma_prefetchNextCache.blockIndex)){
+        blockIndex = rma_prefetchNextCache.blockIndex;
+    }
+
+    size_t nextIndex = SIZE_MAX;
+    if (blockIndex != SIZE_MAX){
+        if (nextHandle != RMA_INVALID_HANDLE) nextIndex = rma_findBlockByHandle(header, nextHandle);
+    }
+    else if (nextHandle != RMA_INVALID_HANDLE){
+        // one pass resolves both handles
+        uint16_t salts[2] = { (uint16_t)(handle >> 16), (uint16_t)(nextHandle >> 16) };
+        int const swapped = salts[0] > salts[1];
+        if (swapped){
+            uint16_t const salt = salts[0];
+            salts[0] = salts[1];
+            salts[1] = salt;
+        }
+
+        size_t indices[2];
+        rma_findBlocksBySalts(header, salts, 2, indices);
+
+        blockIndex = indices[swapped ? 1 : 0];
+        nextIndex = indices[swapped ? 0 : 1];
+
+        // salts matched, make sure the whole handles do
+        if (blockIndex != SIZE_MAX && !rma_isResolvedTo(header, handle, blockIndex)) blockIndex = SIZE_MAX;
+        if (nextIndex != SIZE_MAX && !rma_isResolvedTo(header, nextHandle, nextIndex)) nextIndex = SIZE_MAX;
+    }
+    else {
+        blockIndex = rma_findBlockByHandle(header, handle);
+    }
+
+    // deduplicated handles are not in the handle table
+    if (header->numAliases > 0){
+        if (blockIndex == SIZE_MAX) blockIndex = rma_findBlockByHandle(header, handle);
+        if (nextIndex == SIZE_MAX && nextHandle != RMA_INVALID_HANDLE) nextIndex = rma_findBlockByHandle(header, nextHandle);
+    }
+
+    rma_prefetchNextCache.header = header;
+    rma_prefetchNextCache.handle = nextIndex != SIZE_MAX ? nextHandle : RMA_INVALID_HANDLE;
+    rma_prefetchNextCache.blockIndex = nextIndex;
+
+    if (blockIndex != SIZE_MAX) rma_markReferenced(header, blockIndex);
+    if (nextIndex != SIZE_MAX) rma_prefetchBlock(rma_getBlockPtr(header, nextIndex), header->blockSize, RMA_PREFETCH_READ, 3);
+
+    void *block = blockIndex != SIZE_MAX ? rma_getBlockPtr(header, blockIndex) : NULL;
+
+    rma_poolUnlock(guard);
+
+    return block;
 }
 
-int rma_free(struct rma_mem_header_t *header, rma_handle_t handle){
-    // Validate the handle
-    int const validity = rma_isValidHandle(header, handle);
-    if (validity <= 0) return validity; // Handle is invalid, pass through the error code
+void* rma_meta(struct rma_mem_header_t *header, rma_handle_t handle){
+    if (header == NULL || header->metaTableOffset == 0 || handle == RMA_INVALID_HANDLE) return NULL;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+    size_t const blockIndex = rma_findBlockByHandle(header, handle);
+    void *slot = blockIndex != SIZE_MAX ? rma_getMetaTable(header) + blockIndex * header->options.metaWidth : NULL;
+    rma_poolUnlock(guard);
+
+    return slot;
+}
+
+void* rma_metaTable(struct rma_mem_header_t *header){
+    if (header == NULL) return NULL;
+    return rma_getMetaTable(header);
+}
+
+rma_handle_t rma_handleAt(struct rma_mem_header_t *header, size_t blockIndex){
+    if (header == NULL || blockIndex >= header->numBlocks) return RMA_INVALID_HANDLE;
+    if (!rma_isBlockAllocated(rma_getBitmap(header), blockIndex)) return RMA_INVALID_HANDLE;
+
+    return rma_getHandleTable(header)[blockIndex];
+}
+
+rma_handle_t rma_allocWithTTL(struct rma_mem_header_t *header, uint64_t ttl){
+    if (header == NULL || header->ttlTableOffset == 0) return RMA_INVALID_HANDLE;
+
+    return rma_allocTimed(header, header->blockSize, rma_allocTtlStep, &ttl);
+}
+
+int rma_setTTL(struct rma_mem_header_t *header, rma_handle_t handle, uint64_t ttl){
+    if (header == NULL || header->ttlTableOffset == 0 || handle == RMA_INVALID_HANDLE) return 0;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
 
-    // Find the block
     size_t const blockIndex = rma_findBlockByHandle(header, handle);
+    if (blockIndex != SIZE_MAX){
+        struct rma_ttl_entry_t *entry = &rma_getTtlTable(header)[blockIndex];
+        if (entry->expiry){
+            rma_ttlUnlink(header, blockIndex);
+            rma_statAdd(&header->numTimers, -1);
+        }
+
+        entry->expiry = ttl ? header->currentTick + ttl : 0;
+        if (entry->expiry){
+            rma_ttlLink(header, blockIndex);
+            rma_statAdd(&header->numTimers, 1);
+        }
+    }
+
+    rma_poolUnlock(guard);
+
+    return blockIndex != SIZE_MAX;
+}
+
+size_t rma_expire(struct rma_mem_header_t *header, uint64_t now, rma_block_callback_t onExpire, void *context){
+    if (header == NULL || header->ttlTableOffset == 0) return 0;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+    struct rma_timer_wheel_t *wheel = rma_getTimerWheel(header);
+    uint64_t const slotMask = RMA_TTL_WHEEL_SLOTS - 1;
+    size_t expired = 0;
+
+    while (header->currentTick < now){
+        if (header->numTimers == 0){
+            header->currentTick = now;
+            break;
+        }
+
+        // jump straight to the next due level 0 slot or occupied cascade
+        uint64_t const tick = rma_ttlNextTick(header, now);
+        header->currentTick = tick;
+
+        // cascade every level whose slot boundary this tick crosses, highest first
+        size_t levels = 1;
+        while (levels < RMA_TTL_WHEEL_LEVELS && (tick & (((uint64_t)1 << (RMA_TTL_SLOT_BITS * levels)) - 1)) == 0) levels++;
+        for (size_t level = levels - 1; level > 0; level--){
+            rma_ttlCascade(header, level, (size_t)(tick >> (RMA_TTL_SLOT_BITS * level)) & slotMask);
+        }
+
+        // everything left in the level 0 slot is due
+        uint32_t *head = &wheel->heads[tick & slotMask];
+        while (*head){
+            size_t const blockIndex = *head - 1;
+            rma_handle_t const handle = rma_getHandleTable(header)[blockIndex];
+
+            if (onExpire) onExpire(header, handle, context);
+
+            // the callback may have freed, re-armed or cancelled the block, none of which counts
+            if (*head == blockIndex + 1){
+                rma_releaseBlock(header, blockIndex);
+                expired++;
+            }
+        }
+    }
+
+    rma_poolUnlock(guard);
+
+    return expired;
+}
+
+rma_handle_t rma_allocOrEvict(struct rma_mem_header_t *header, rma_block_callback_t onEvict, void *context){
+    if (header == NULL || header->refBitmapOffset == 0) return RMA_INVALID_HANDLE;
+
+    struct rma_evict_args_t const args = { onEvict, context };
+    return rma_allocTimed(header, header->blockSize, rma_allocEvictStep, &args);
+}
+
+uint32_t rma_beginEpoch(struct rma_mem_header_t *header){
+    if (header == NULL || header->epochTableOffset == 0) return 0;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+
+    // skip 0 when the epoch counter wraps, 0 means "no epoch"
+    if (header->nextEpoch == 0) header->nextEpoch = 1;
+
+    uint32_t const epoch = header->currentEpoch = header->nextEpoch++;
+    rma_poolUnlock(guard);
+
+    return epoch;
+}
+
+void rma_endEpoch(struct rma_mem_header_t *header){
+    if (header == NULL) return;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+    header->currentEpoch = 0;
+    rma_poolUnlock(guard);
+}
+
+size_t rma_freeEpoch(struct rma_mem_header_t *header, uint32_t epoch){
+    if (header == NULL || epoch == 0) return 0;
+
+    uint32_t *epochTable = rma_getEpochTable(header);
+    if (epochTable == NULL) return 0;
+
+    // the sweep releases blocks like rma_free(), so it must not race allocators
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
 
-    // Update all the data structures
     uint32_t *bitmap = rma_getBitmap(header);
-    uint32_t *handleTable = rma_getHandleTable(header);
+    size_t const bitmapWords = (header->numBlocks + 31) / 32;
+    size_t freed = 0;
+
+    for (size_t word = 0; word < bitmapWords; word++){
+        // skip fully free words without touching their tags
+        if (bitmap[word] == 0) continue;
+
+        // branch-free compare of 32 tags, the compiler turns this into SIMD compares
+        uint32_t const *tags = &epochTable[word * 32];
+        uint32_t match = 0;
+        for (uint32_t bit = 0; bit < 32; bit++){
+            match |= (uint32_t)(tags[bit] == epoch) << bit;
+        }
 
-    // Clear the block
-    rma_markBlockFree(bitmap, blockIndex);
-    handleTable[blockIndex] = 0; // Clear the salt
+        match &= bitmap[word];
 
-    // Update statistics
-    header->numAllocated--;
-    header->usedSize -= header->blockSize;
+        // release every matching block
+        while (match != 0){
+            uint32_t const bit = (uint32_t)__builtin_ctz(match);
+            match &= match - 1;
+            rma_releaseBlock(header, word * 32 + bit);
+            freed++;
+        }
+    }
+
+    if (header->currentEpoch == epoch) header->currentEpoch = 0;
 
-    return 1; // success
+    rma_poolUnlock(guard);
+
+    return freed;
 }
 
-void* rma_getPtr(struct rma_mem_header_t *header, rma_handle_t handle){
-    // validate header and handle
+struct rma_mem_header_t* rma_clone(struct rma_mem_header_t *header){
     if (header == NULL) return NULL;
-    if (rma_isValidHandle(header, handle) <= 0) return NULL;
 
-    // get the block index
-    size_t const blockIndex = rma_findBlockByHandle(header, handle);
+    // allocations must not change the pool halfway through the copy
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+
+    // the children's runs would be copied as allocated blocks nobody can free
+    if (header->numChildren > 0){
+        rma_poolUnlock(guard);
+        return NULL;
+    }
+
+    size_t mappedSize = 0, mapGranularity = 0;
+    int backing = 0;
+    struct rma_mem_header_t *clone = rma_acquireBacking(header->totalSize, &header->options, &backing, &mappedSize, &mapGranularity);
+    if (clone == NULL){
+        rma_poolUnlock(guard);
+        return NULL;
+    }
+
+    // header and all metadata are copied verbatim, so handles stay valid
+    memcpy(clone, header, header->dataOffset);
+    clone->backing = backing;
+    clone->mappedSize = mappedSize;
+    clone->mapGranularity = mapGranularity;
+
+    // synchronization state belongs to the source pool
+    clone->lockWord = 0;
+    clone->freeSequence = 0;
+    clone->waiters = 0;
+    clone->eventFd = -1;
+    clone->registered = 0;
+    clone->statsPage = NULL;
+
+    // a clone is a standalone pool that doesn't return a run to a parent
+    clone->parent = NULL;
+    for (size_t stripe = 0; clone->lockTableOffset && stripe < clone->options.lockStripes; stripe++){
+        ((struct rma_lock_stripe_t*)((char*)clone + clone->lockTableOffset))[stripe].word = 0;
+    }
+
+    size_t const numRuns = rma_collectAllocatedRuns(header, NULL);
+    if (numRuns == 0){
+        rma_poolUnlock(guard);
+        return clone;
+    }
+
+    struct rma_block_run_t *runs = malloc(numRuns * sizeof(*runs));
+    if (runs == NULL){
+        rma_destroy(clone);
+        rma_poolUnlock(guard);
+        return NULL;
+    }
+    rma_collectAllocatedRuns(header, runs);
+
+    struct rma_clone_job_t job = {
+        .source = (char const*)header + header->dataOffset,
+        .destination = (char*)clone + header->dataOffset,
+        .blockStride = header->blockStride,
+        .runs = runs,
+        .numRuns = numRuns
+    };
+
+    // small pools are copied on the calling thread
+    size_t const allocatedBytes = header->numAllocated * header->blockSize;
+    long const cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t numThreads = cpus > 1 ? (size_t)cpus : 1;
+    if (numThreads > RMA_CLONE_MAX_THREADS) numThreads = RMA_CLONE_MAX_THREADS;
+    if (allocatedBytes < RMA_CLONE_PARALLEL_THRESHOLD || numRuns < numThreads) numThreads = 1;
+
+    if (numThreads == 1){
+        rma_cloneCopyRuns(&job);
+        free(runs);
+        rma_poolUnlock(guard);
+        return clone;
+    }
+
+    // split the runs so every thread copies roughly the same number of bytes
+    pthread_t threads[RMA_CLONE_MAX_THREADS];
+    struct rma_clone_job_t jobs[RMA_CLONE_MAX_THREADS];
+    size_t started = 0, run = 0;
+    size_t const blocksPerThread = (header->numAllocated + numThreads - 1) / numThreads;
+
+    for (size_t t = 0; t < numThreads && run < numRuns; t++){
+        jobs[t] = job;
+        jobs[t].runs = &runs[run];
+
+        size_t blocks = 0;
+        while (run < numRuns && (blocks < blocksPerThread || t == numThreads - 1)){
+            blocks += runs[run++].count;
+        }
+        jobs[t].numRuns = (size_t)(&runs[run] - jobs[t].runs);
+
+        // fall back to copying inline if a thread can't be started
+        if (pthread_create(&threads[started], NULL, rma_cloneCopyRuns, &jobs[t]) == 0) started++;
+        else rma_cloneCopyRuns(&jobs[t]);
+    }
+
+    for (size_t t = 0; t < started; t++) pthread_join(threads[t], NULL);
+
+    free(runs);
+    rma_poolUnlock(guard);
+    return clone;
+}
+
+struct rma_mem_header_t* rma_resize(struct rma_mem_header_t *header, size_t newTotalSize){
+    if (header == NULL || header->numChildren > 0) return NULL;
+    if (!header->registered) return rma_resizePool(header, newTotalSize);
+
+    // introspection must not look at the pool while it moves
+    pthread_mutex_lock(&rma_registry.lock);
+
+    struct rma_mem_header_t *resized = rma_resizePool(header, newTotalSize);
+    for (size_t i = 0; resized != NULL && i < rma_registry.count; i++){
+        if (rma_registry.entries[i].header == header) rma_registry.entries[i].header = resized;
+    }
+
+    pthread_mutex_unlock(&rma_registry.lock);
+
+    return resized;
+}
+
+int rma_pin(struct rma_mem_header_t *header, rma_handle_t handle){
+    int const validity = rma_isValidHandle(header, handle);
+    if (validity <= 0) return validity;
+
+    rma_markBlockAllocated(rma_getPinnedBitmap(header), rma_findBlockByHandle(header, handle));
+    return 1;
+}
+
+int rma_unpin(struct rma_mem_header_t *header, rma_handle_t handle){
+    int const validity = rma_isValidHandle(header, handle);
+    if (validity <= 0) return validity;
+
+    rma_markBlockFree(rma_getPinnedBitmap(header), rma_findBlockByHandle(header, handle));
+    return 1;
+}
+
+int rma_lock(struct rma_mem_header_t *header, rma_handle_t handle){
+    struct rma_lock_stripe_t *stripe = header != NULL ? rma_getLockStripe(header, handle) : NULL;
+    if (stripe == NULL) return 0;
+
+    // same three-state futex lock as rma_poolLock()
+    uint32_t state = 0;
+    if (!__atomic_compare_exchange_n(&stripe->word, &state, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)){
+        if (state != 2) state = __atomic_exchange_n(&stripe->word, 2, __ATOMIC_ACQUIRE);
+        while (state != 0){
+            rma_futex(&stripe->word, FUTEX_WAIT, 2, NULL);
+            state = __atomic_exchange_n(&stripe->word, 2, __ATOMIC_ACQUIRE);
+        }
+        rma_statAdd(&stripe->contended, 1);
+    }
+
+    // the counters are only written by the lock holder
+    rma_statAdd(&stripe->acquisitions, 1);
+    return 1;
+}
 
-    // if finding the block failed, return NULL
-    if (blockIndex == SIZE_MAX) return NULL;
+int rma_unlock(struct rma_mem_header_t *header, rma_handle_t handle){
+    struct rma_lock_stripe_t *stripe = header != NULL ? rma_getLockStripe(header, handle) : NULL;
+    if (stripe == NULL) return 0;
 
-    // get the memory adress using my static helper function and return it 
-    return (void *)rma_getBlockPtr(header, blockIndex);
+    if (__atomic_fetch_sub(&stripe->word, 1, __ATOMIC_RELEASE) != 1){
+        __atomic_store_n(&stripe->word, 0, __ATOMIC_RELEASE);
+        rma_futex(&stripe->word, FUTEX_WAKE, 1, NULL);
+    }
+    return 1;
+}
+
+size_t rma_compact(struct rma_mem_header_t *header){
+    if (header == NULL) return 0;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+
+    uint32_t const *bitmap = rma_getBitmap(header);
+    size_t moved = 0;
+
+    // two fingers: lowest free slot and highest movable block
+    size_t freeIndex = rma_findNextBlock(bitmap, 0, header->numBlocks, 0);
+    size_t usedIndex = rma_findPrevMovableBlock(header, header->numBlocks);
+
+    while (usedIndex != SIZE_MAX && freeIndex < usedIndex){
+        rma_moveBlock(header, usedIndex, freeIndex);
+        moved++;
+
+        freeIndex = rma_findNextBlock(bitmap, freeIndex + 1, header->numBlocks, 0);
+        usedIndex = rma_findPrevMovableBlock(header, usedIndex);
+    }
+
+    rma_poolUnlock(guard);
+
+    RMA_PROBE(compact, header, moved);
+
+    return moved;
+}
+
+size_t rma_shrinkToFit(struct rma_mem_header_t *header, unsigned slackPercent){
+    if (header == NULL) return 0;
+
+    // numBlocks shrinks below lock-free rma_getStats() readers
+    int const registered = header->registered;
+    if (registered) pthread_mutex_lock(&rma_registry.lock);
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+
+    rma_compact(header);
+
+    // pinned blocks may still sit past the compacted prefix
+    size_t lastUsed = 0;
+    uint32_t const *bitmap = rma_getBitmap(header);
+    for (size_t word = (header->numBlocks + 31) / 32; word > 0; word--){
+        if (bitmap[word - 1] != 0){
+            lastUsed = (word - 1) * 32 + 32 - (size_t)__builtin_clz(bitmap[word - 1]);
+            break;
+        }
+    }
+
+    size_t targetBlocks = header->numAllocated + header->numAllocated * slackPercent / 100;
+    if (targetBlocks < lastUsed) targetBlocks = lastUsed;
+    if (targetBlocks == 0) targetBlocks = 1;
+
+    size_t released = 0;
+
+    // truncate in place: the data section keeps its offset so pinned blocks don't move,
+    // the metadata arrays simply stay sized for the old block count
+    if (targetBlocks < header->numBlocks){
+        size_t const oldMappedSize = header->mappedSize;
+
+        header->numBlocks = targetBlocks;
+        header->totalSize = header->dataOffset + targetBlocks * header->blockStride;
+
+        // only mappings can be trimmed in place, malloc pools just shrink logically
+        if (header->backing == RMA_BACKING_MMAP && rma_resizeBacking(header, header->totalSize, 0) != NULL){
+            released += oldMappedSize - header->mappedSize;
+        }
+    }
+
+    // the slack inside the pool can go back to the OS too
+    if (header->backing == RMA_BACKING_MMAP) released += rma_adviseFreeRuns(header);
+
+    if (header->statsPage) rma_statsPageUpdate(header, 0, 0, 1);
+
+    rma_poolUnlock(guard);
+    if (registered) pthread_mutex_unlock(&rma_registry.lock);
+
+    RMA_PROBE(trim, header, released);
+
+    return released;
+}
+
+size_t rma_trim(struct rma_mem_header_t *header){
+    if (header == NULL) return 0;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+
+    size_t const released = header->backing == RMA_BACKING_MMAP ? rma_adviseFreeRuns(header) : 0;
+
+    rma_poolUnlock(guard);
+
+    RMA_PROBE(trim, header, released);
+
+    return released;
+}
+
+int rma_getStats(struct rma_mem_header_t *header, struct rma_stats_t *stats){
+    if (header == NULL || stats == NULL) return 0;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->totalSize = __atomic_load_n(&header->totalSize, __ATOMIC_RELAXED);
+    stats->blockSize = header->blockSize;
+    stats->numBlocks = __atomic_load_n(&header->numBlocks, __ATOMIC_RELAXED);
+    stats->numAllocated = __atomic_load_n(&header->numAllocated, __ATOMIC_RELAXED);
+    stats->usedSize = __atomic_load_n(&header->usedSize, __ATOMIC_RELAXED);
+    stats->numTimers = __atomic_load_n(&header->numTimers, __ATOMIC_RELAXED);
+    stats->numIndexed = __atomic_load_n(&header->numIndexed, __ATOMIC_RELAXED);
+    stats->numAliases = __atomic_load_n(&header->numAliases, __ATOMIC_RELAXED);
+
+    // walk the free runs a word at a time, every word is loaded once
+    uint32_t const *bitmap = rma_getBitmap(header);
+    size_t run = 0;
+    for (size_t word = 0; word * 32 < stats->numBlocks; word++){
+        uint32_t const bits = __atomic_load_n(&bitmap[word], __ATOMIC_RELAXED);
+        size_t const valid = stats->numBlocks - word * 32 < 32 ? stats->numBlocks - word * 32 : 32;
+
+        for (size_t bit = 0; bit < valid; ){
+            uint32_t const shifted = bits >> bit;
+
+            if (!(shifted & 1u)){
+                // stretch of free blocks, it may continue in the next word
+                size_t length = shifted ? (size_t)__builtin_ctz(shifted) : 32 - bit;
+                if (bit + length > valid) length = valid - bit;
+                run += length;
+                bit += length;
+            }
+            else {
+                rma_statsAddRun(stats, run);
+                run = 0;
+
+                // skip the allocated stretch in one step
+                uint32_t const rest = ~shifted;
+                bit += rest ? (size_t)__builtin_ctz(rest) : 32;
+            }
+        }
+    }
+    rma_statsAddRun(stats, run);
+
+    // internal fragmentation of the blocks whose size is known
+    uint32_t const *sizeTable = rma_getSizeTable(header);
+    for (size_t blockIndex = 0; sizeTable && blockIndex < stats->numBlocks; blockIndex++){
+        size_t const size = __atomic_load_n(&sizeTable[blockIndex], __ATOMIC_RELAXED);
+        if (size == 0) continue;
+
+        stats->sizedBlocks++;
+        stats->requestedBytes += size;
+        stats->sizeHistogram[63 - __builtin_clzll(size)]++;
+    }
+    stats->wastedBytes = stats->sizedBlocks * stats->blockSize - stats->requestedBytes;
+
+    struct rma_lock_stripe_t const *stripes = header->lockTableOffset ? (struct rma_lock_stripe_t const*)((char*)header + header->lockTableOffset) : NULL;
+    for (size_t stripe = 0; stripes && stripe < header->options.lockStripes; stripe++){
+        stats->lockAcquisitions += __atomic_load_n(&stripes[stripe].acquisitions, __ATOMIC_RELAXED);
+        stats->lockContended += __atomic_load_n(&stripes[stripe].contended, __ATOMIC_RELAXED);
+    }
+    stats->lockStripes = stripes ? header->options.lockStripes : 0;
+
+    return 1;
+}
+
+int rma_registerPool(struct rma_mem_header_t *header, char const *name){
+    if (header == NULL || name == NULL) return 0;
+
+    pthread_mutex_lock(&rma_registry.lock);
+
+    int const added = !header->registered && rma_registry.count < RMA_REGISTRY_MAX;
+    if (added){
+        rma_registry.entries[rma_registry.count].header = header;
+        snprintf(rma_registry.entries[rma_registry.count].name, RMA_POOL_NAME_MAX, "%s", name);
+        rma_registry.count++;
+        header->registered = 1;
+    }
+
+    pthread_mutex_unlock(&rma_registry.lock);
+
+    return added;
+}
+
+int rma_unregisterPool(struct rma_mem_header_t *header){
+    if (header == NULL) return 0;
+
+    pthread_mutex_lock(&rma_registry.lock);
+
+    int removed = 0;
+    for (size_t i = 0; i < rma_registry.count; i++){
+        if (rma_registry.entries[i].header != header) continue;
+
+        // order doesn't matter, fill the hole with the last entry
+        rma_registry.entries[i] = rma_registry.entries[--rma_registry.count];
+        header->registered = 0;
+        removed = 1;
+        break;
+    }
+
+    pthread_mutex_unlock(&rma_registry.lock);
+
+    return removed;
+}
+
+size_t rma_forEachPool(rma_pool_visitor_t visitor, void *context){
+    if (visitor == NULL) return 0;
+
+    pthread_mutex_lock(&rma_registry.lock);
+
+    size_t const count = rma_registry.count;
+    for (size_t i = 0; i < count; i++){
+        visitor(rma_registry.entries[i].header, rma_registry.entries[i].name, context);
+    }
+
+    pthread_mutex_unlock(&rma_registry.lock);
+
+    return count;
+}
+
+int rma_txBegin(void){
+    if (rma_txLog.depth == RMA_TX_MAX_DEPTH) return 0;
+
+    rma_txLog.marks[rma_txLog.depth++] = rma_txLog.count;
+    return 1;
+}
+
+int rma_txCommit(void){
+    if (rma_txLog.depth == 0) return 0;
+
+    // the outermost commit drops the log, inner ones hand their entries to the parent
+    if (--rma_txLog.depth == 0) rma_txLog.count = 0;
+    return 1;
+}
+
+size_t rma_txAbort(void){
+    if (rma_txLog.depth == 0) return 0;
+
+    size_t const start = rma_txLog.marks[--rma_txLog.depth];
+    struct rma_tx_entry_t *entries = &rma_txLog.entries[start];
+    size_t count = rma_txLog.count - start;
+
+    // compact away tombstones of blocks freed inside the transaction
+    size_t live = 0;
+    for (size_t i = 0; i < count; i++){
+        if (entries[i].handle != RMA_INVALID_HANDLE) entries[live++] = entries[i];
+    }
+    count = live;
+
+    // group by pool, then free every pool's run in one sweep
+    qsort(entries, count, sizeof(*entries), rma_txCompareEntries);
+
+    size_t freed = 0;
+    for (size_t first = 0; first < count; ){
+        size_t last = first;
+        while (last < count && entries[last].header == entries[first].header) last++;
+
+        freed += rma_txReleaseBatch(entries[first].header, &entries[first], last - first);
+        first = last;
+    }
+
+    rma_txLog.count = start;
+    return freed;
+}
+
+unsigned char* rma_renderHeatmap(struct rma_mem_header_t *header, size_t *size){
+    if (header == NULL || size == NULL) return NULL;
+
+    size_t const numBlocks = __atomic_load_n(&header->numBlocks, __ATOMIC_RELAXED);
+    size_t const blocksPerPage = header->blockStride < RMA_HEATMAP_PAGE ? RMA_HEATMAP_PAGE / header->blockStride : 1;
+    size_t const minGroup = (numBlocks + RMA_HEATMAP_MAX_PIXELS - 1) / RMA_HEATMAP_MAX_PIXELS;
+    size_t const group = blocksPerPage > minGroup ? blocksPerPage : minGroup;
+
+    size_t const pixels = (numBlocks + group - 1) / group;
+    size_t const width = pixels < RMA_HEATMAP_WIDTH ? pixels : RMA_HEATMAP_WIDTH;
+    size_t const height = (pixels + width - 1) / width;
+
+    char preamble[128];
+    size_t const allocated = __atomic_load_n(&header->numAllocated, __ATOMIC_RELAXED);
+    int const preambleLength = snprintf(preamble, sizeof(preamble), "P5\n# rma blocks=%zu blocksPerPixel=%zu pixels=%zu allocated=%zu\n%zu %zu\n255\n",
+                                      numBlocks, group, pixels, allocated, width, height);
+
+    size_t const frameSize = (size_t)preambleLength + width * height;
+    unsigned char *frame = calloc(1, frameSize);
+    if (frame == NULL) return NULL;
+    memcpy(frame, preamble, (size_t)preambleLength);
+
+    uint32_t const *bitmap = rma_getBitmap(header);
+    unsigned char *pixel = frame + preambleLength;
+    for (size_t first = 0; first < numBlocks; first += group){
+        size_t const last = first + group < numBlocks ? first + group : numBlocks;
+        *pixel++ = (unsigned char)(rma_countAllocated(bitmap, first, last) * 255 / (last - first));
+    }
+
+    *size = frameSize;
+    return frame;
+}
+
+int rma_dumpHeatmap(struct rma_mem_header_t *header, int fd){
+    size_t frameSize = 0;
+    unsigned char *frame = rma_renderHeatmap(header, &frameSize);
+    if (frame == NULL) return 0;
+
+    // the whole frame goes out in one write(), so periodic frames never interleave
+    size_t written = 0;
+    while (written < frameSize){
+        ssize_t const result = write(fd, frame + written, frameSize - written);
+        if (result < 0 && errno == EINTR) continue;
+        if (result <= 0) break;
+        written += (size_t)result;
+    }
+
+    free(frame);
+    return written == frameSize;
 }
 
 void rma_displayMemInfo(struct rma_mem_header_t *header){
@@ -393,8 +3837,10 @@ void rma_displayMemInfo(struct rma_mem_header_t *header){
     printf("├─ Bitmap Offset:          +%zu bytes\n", header->bitmapOffset);
     printf("├─ Handle Table Offset:    +%zu bytes\n", header->handleTableOffset);
     printf("├─ Data Section Offset:    +%zu bytes\n", header->dataOffset);
-    printf("└─ Block Size:             %zu bytes (%.2f KiB)\n", 
+    printf("├─ Block Size:             %zu bytes (%.2f KiB)\n", 
            header->blockSize, (double)header->blockSize / 1024.0);
+    printf("└─ Block Stride:           %zu bytes (%zu cache colors)\n",
+           header->blockStride, rma_blockColors(header));
 
     // === CAPACITY INFORMATION ===
     printf("\nCAPACITY:\n");
@@ -416,7 +3862,7 @@ void rma_displayMemInfo(struct rma_mem_header_t *header){
     printf("├─ Block Utilization:      %.2f%%\n",
            header->numBlocks > 0 ? ((double)header->numAllocated / header->numBlocks) * 100.0 : 0.0);
     printf("└─ Theoretical Max Blocks: %zu blocks\n",
-           (header->totalSize - sizeof(struct rma_mem_header_t)) / header->blockSize);
+           (header->totalSize - sizeof(struct rma_mem_header_t)) / header->blockStride);
 
     // === MEMORY USAGE ===
     printf("\nMEMORY USAGE:\n");
@@ -431,6 +3877,30 @@ void rma_displayMemInfo(struct rma_mem_header_t *header){
            header->numAllocated == 0 ? "None (no allocations)" : 
            header->numBlocks == header->numAllocated ? "None (fully allocated)" : "Possible");
 
+    // === DEDUPLICATION ===
+    if (header->dedupBlocksOffset){
+        printf("\nDEDUPLICATION:\n");
+        printf("├─ Indexed Blocks:         %zu blocks\n", header->numIndexed);
+        printf("├─ Merged Handles:         %zu handles\n", header->numAliases);
+        printf("├─ Bytes Saved:            %zu bytes\n", header->numAliases * header->blockSize);
+        printf("└─ Dedup Ratio:            %.2f handles/block\n",
+               header->numAllocated > 0 ? (double)(header->numAllocated + header->numAliases) / header->numAllocated : 1.0);
+    }
+
+    // === INTERNAL FRAGMENTATION ===
+    if (header->sizeTableOffset){
+        struct rma_stats_t stats;
+        rma_getStats(header, &stats);
+
+        printf("\nINTERNAL FRAGMENTATION:\n");
+        printf("├─ Sized Blocks:           %zu blocks\n", stats.sizedBlocks);
+        printf("├─ Requested Bytes:        %zu bytes\n", stats.requestedBytes);
+        printf("├─ Wasted Bytes:           %zu bytes (%.2f%% of sized blocks)\n", stats.wastedBytes,
+               stats.sizedBlocks ? 100.0 * (double)stats.wastedBytes / (double)(stats.sizedBlocks * stats.blockSize) : 0.0);
+        printf("└─ Average Request:        %.1f bytes\n",
+               stats.sizedBlocks ? (double)stats.requestedBytes / (double)stats.sizedBlocks : 0.0);
+    }
+
     // === HANDLE INFORMATION ===
     printf("\nHANDLE MANAGEMENT:\n");
     printf("├─ Next Handle ID:         %u\n", header->nextHandle);
@@ -515,4 +3985,102 @@ void rma_displayMemInfo(struct rma_mem_header_t *header){
 
     printf("\n");
     printf("═══════════════════════════════════════════════════════════════\n");
-}
\ No newline at end of file
+}
+
+int rma_publishStats(struct rma_mem_header_t *header, char const *name){
+    if (header == NULL || name == NULL || header->statsPage != NULL) return 0;
+
+    // the name becomes part of a file name
+    char safeName[RMA_POOL_NAME_MAX];
+    snprintf(safeName, sizeof(safeName), "%s", name);
+    for (char *c = safeName; *c; c++){
+        if (*c == '/') *c = '_';
+    }
+
+    char path[128];
+    rma_statsPagePath((int)getpid(), safeName, path, sizeof(path));
+
+    int const fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return 0;
+
+    struct rma_stats_page_t *page = MAP_FAILED;
+    if (ftruncate(fd, sizeof(*page)) == 0){
+        page = mmap(NULL, sizeof(*page), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (page == MAP_FAILED){
+        unlink(path);
+        return 0;
+    }
+
+    page->version = RMA_STATS_PAGE_VERSION;
+    page->pid = (int32_t)getpid();
+    memcpy(page->name, safeName, sizeof(safeName));
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+    __atomic_store_n(&header->statsPage, page, __ATOMIC_RELEASE);
+    rma_statsPageUpdate(header, 0, 0, 1);
+    rma_poolUnlock(guard);
+
+    // readers ignore the page until it is complete
+    __atomic_store_n(&page->magic, RMA_STATS_PAGE_MAGIC, __ATOMIC_RELEASE);
+
+    return 1;
+}
+
+void rma_unpublishStats(struct rma_mem_header_t *header){
+    if (header == NULL || header->statsPage == NULL) return;
+
+    struct rma_pool_guard_t const guard = rma_poolLock(header);
+    struct rma_stats_page_t *page = header->statsPage;
+    __atomic_store_n(&header->statsPage, NULL, __ATOMIC_RELEASE);
+    rma_poolUnlock(guard);
+
+    char path[128];
+    rma_statsPagePath(page->pid, page->name, path, sizeof(path));
+    unlink(path);
+    munmap(page, sizeof(*page));
+}
+
+int rma_readStatsPage(struct rma_stats_page_t const *page, struct rma_stats_page_t *copy){
+    if (page == NULL || copy == NULL) return 0;
+    if (__atomic_load_n(&page->magic, __ATOMIC_ACQUIRE) != RMA_STATS_PAGE_MAGIC || page->version != RMA_STATS_PAGE_VERSION) return 0;
+
+    memset(copy, 0, sizeof(*copy));
+    copy->magic = page->magic;
+    copy->version = page->version;
+    copy->pid = page->pid;
+    memcpy(copy->name, page->name, sizeof(copy->name));
+    copy->name[sizeof(copy->name) - 1] = '\0';
+
+    // a writer that died mid-update leaves the sequence odd forever, so give up eventually
+    for (int attempt = 0; attempt < 1000; attempt++){
+        uint64_t const sequence = __atomic_load_n(&page->sequence, __ATOMIC_ACQUIRE);
+        if (sequence & 1){
+            sched_yield();
+            continue;
+        }
+
+        copy->totalSize = __atomic_load_n(&page->totalSize, __ATOMIC_RELAXED);
+        copy->blockSize = __atomic_load_n(&page->blockSize, __ATOMIC_RELAXED);
+        copy->numBlocks = __atomic_load_n(&page->numBlocks, __ATOMIC_RELAXED);
+        copy->numAllocated = __atomic_load_n(&page->numAllocated, __ATOMIC_RELAXED);
+        copy->allocs = __atomic_load_n(&page->allocs, __ATOMIC_RELAXED);
+        copy->frees = __atomic_load_n(&page->frees, __ATOMIC_RELAXED);
+        copy->freeRuns = __atomic_load_n(&page->freeRuns, __ATOMIC_RELAXED);
+        copy->largestFreeRun = __atomic_load_n(&page->largestFreeRun, __ATOMIC_RELAXED);
+        copy->updates = __atomic_load_n(&page->updates, __ATOMIC_RELAXED);
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&page->sequence, __ATOMIC_RELAXED) != sequence) continue;
+
+        copy->sequence = sequence;
+        for (size_t bucket = 0; bucket < RMA_LATENCY_BUCKETS; bucket++){
+            copy->latency[bucket] = __atomic_load_n(&page->latency[bucket], __ATOMIC_RELAXED);
+        }
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file memHeatmap.c
+ * @brief Periodic heatmap recording of a registered pool
+ * @author Robkoo
+ * @date 18.10.2026
+ * @version 0.0.3
+ * @since 0.0.3
+ *
+ * One recorder thread sleeps on an eventfd with the frame interval as
+ * poll() timeout, so rma_heatmapStop() wakes it immediately. Frames are
+ * rendered inside rma_forEachPool(), which keeps the pool from being
+ * destroyed or moved while its bitmap is read, and written once the
+ * registry lock is released, so a slow destination never blocks pool
+ * registration or the introspection server.
+ */
+
+#define _GNU_SOURCE
+
+#include "memHeatmap.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+/**
+ * @brief State of the running recording
+ */
+static struct {
+    int running;                    /**< Nonzero while the thread runs */
+    int fd;                         /**< Destination of the frames */
+    int stopFd;                     /**< eventfd signalled by rma_heatmapStop() */
+    unsigned intervalMs;            /**< Time between frames */
+    size_t frames;                  /**< Frames written so far */
+    char poolName[RMA_POOL_NAME_MAX]; /**< Registered name of the recorded pool */
+    pthread_t thread;               /**< Recorder thread */
+} rma_heatmap = { .fd = -1, .stopFd = -1 };
+
+/**
+ * @brief Frame rendered by rma_heatmapVisit()
+ */
+struct rma_heatmap_frame_t {
+    unsigned char *data;    /**< Frame from rma_renderHeatmap(), NULL if the pool wasn't found */
+    size_t size;            /**< Frame size in bytes */
+};
+
+/**
+ * STATIC HELPER FUNCTIONS
+ */
+
+/**
+ * @brief Render a frame of the recorded pool (rma_forEachPool() visitor)
+ * @param header Registered pool
+ * @param name Pool name
+ * @param context Pointer to struct rma_heatmap_frame_t receiving the frame
+ */
+static void rma_heatmapVisit(struct rma_mem_header_t *header, char const *name, void *context){
+    struct rma_heatmap_frame_t *frame = context;
+    if (frame->data != NULL || strcmp(name, rma_heatmap.poolName) != 0) return;
+
+    frame->data = rma_renderHeatmap(header, &frame->size);
+}
+
+/**
+ * @brief Append a rendered frame to the destination
+ * @param frame Frame to write (data must not be NULL)
+ * @return 1 if the whole frame was written, 0 otherwise
+ */
+static int rma_heatmapWrite(struct rma_heatmap_frame_t const *frame){
+    size_t written = 0;
+    while (written < frame->size){
+        ssize_t const result = write(rma_heatmap.fd, frame->data + written, frame->size - written);
+        if (result < 0 && errno == EINTR) continue;
+        if (result <= 0) break;
+        written += (size_t)result;
+    }
+
+    return written == frame->size;
+}
+
+/**
+ * @brief Recorder thread: write a frame, then wait for the next interval or the stop signal
+ * @param arg Unused
+ */
+static void* rma_heatmapThread(void *arg){
+    (void)arg;
+
+    for (;;){
+        struct rma_heatmap_frame_t frame = {0};
+        rma_forEachPool(rma_heatmapVisit, &frame);
+
+        if (frame.data != NULL && rma_heatmapWrite(&frame)) rma_heatmap.frames++;
+        free(frame.data);
+
+        struct pollfd stop = { .fd = rma_heatmap.stopFd, .events = POLLIN };
+        if (poll(&stop, 1, (int)rma_heatmap.intervalMs) != 0) break;
+    }
+
+    return NULL;
+}
+
+/**
+ * FUNCTION DEFINITIONS
+ */
+
+int rma_heatmapStart(char const *poolName, int fd, unsigned intervalMs){
+    if (poolName == NULL || fd < 0 || intervalMs < RMA_HEATMAP_MIN_INTERVAL || rma_heatmap.running) return 0;
+
+    int const stopFd = eventfd(0, EFD_CLOEXEC);
+    if (stopFd < 0) return 0;
+
+    rma_heatmap.fd = fd;
+    rma_heatmap.stopFd = stopFd;
+    rma_heatmap.intervalMs = intervalMs;
+    rma_heatmap.frames = 0;
+    snprintf(rma_heatmap.poolName, sizeof(rma_heatmap.poolName), "%s", poolName);
+
+    if (pthread_create(&rma_heatmap.thread, NULL, rma_heatmapThread, NULL) != 0){
+        close(stopFd);
+        rma_heatmap.stopFd = -1;
+        return 0;
+    }
+
+    rma_heatmap.running = 1;
+    return 1;
+}
+
+size_t rma_heatmapStop(void){
+    if (!rma_heatmap.running) return 0;
+
+    uint64_t const wake = 1;
+    if (write(rma_heatmap.stopFd, &wake, sizeof(wake)) != sizeof(wake)) return 0;
+    pthread_join(rma_heatmap.thread, NULL);
+
+    close(rma_heatmap.stopFd);
+    rma_heatmap.stopFd = -1;
+    rma_heatmap.fd = -1;
+    rma_heatmap.running = 0;
+
+    return rma_heatmap.frames;
+}
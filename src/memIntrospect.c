@@ -0,0 +1,447 @@
+/**
+ * @file memIntrospect.c
+ * @brief Live introspection of registered pools over a Unix domain socket
+ * @author Robkoo
+ * @date 18.10.2026
+ * @version 0.0.3
+ * @since 0.0.3
+ *
+ * A single server thread polls the listening socket, the connected
+ * clients and an eventfd used to stop it. Requests are answered inside
+ * rma_forEachPool(), so a pool can't be destroyed or moved while a
+ * response is being built. Queries only read rma_getStats() snapshots.
+ */
+
+#define _GNU_SOURCE
+
+#include "memIntrospect.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+/**
+ * @brief Connected client and its partially received request line
+ */
+struct rma_introspect_client_t {
+    int fd;                                  /**< Client socket (-1 = unused slot) */
+    size_t length;                           /**< Bytes buffered in line */
+    char line[RMA_INTROSPECT_LINE_MAX];      /**< Request being received */
+};
+
+/**
+ * @brief One parsed request, passed to the pool visitor
+ */
+struct rma_introspect_request_t {
+    char const *command;    /**< Command word */
+    char const *pool;       /**< Pool name, or NULL for all pools */
+    FILE *out;              /**< Response being built */
+    size_t matched;         /**< Pools the request applied to */
+};
+
+/**
+ * @brief State of the running server
+ */
+static struct {
+    int running;                    /**< Nonzero while the thread runs */
+    int listenFd;                   /**< Listening socket */
+    int stopFd;                     /**< eventfd signalled by rma_introspectStop() */
+    pthread_t thread;               /**< Server thread */
+    struct sockaddr_un address;     /**< Bound address, unlinked on stop */
+    char snapshotDir[PATH_MAX];     /**< Directory snapshots go to, empty if they are refused */
+    size_t snapshots;               /**< Snapshots taken, numbers the files */
+    struct rma_introspect_client_t clients[RMA_INTROSPECT_MAX_CLIENTS]; /**< Connected clients */
+} rma_introspect = { .listenFd = -1, .stopFd = -1 };
+
+/**
+ * STATIC HELPER FUNCTIONS
+ */
+
+/**
+ * @brief Print the counters of one pool
+ * @param out Response stream (must not be NULL)
+ * @param name Pool name (must not be NULL)
+ * @param stats Snapshot of the pool (must not be NULL)
+ */
+static void rma_introspectStats(FILE *out, char const *name, struct rma_stats_t const *stats){
+    fprintf(out, "%s totalSize=%zu blockSize=%zu blocks=%zu allocated=%zu used=%zu timers=%zu indexed=%zu aliases=%zu sized=%zu wasted=%zu"
+                 " locks=%zu contended=%zu\n",
+            name, stats->totalSize, stats->blockSize, stats->numBlocks, stats->numAllocated, stats->usedSize,
+            stats->numTimers, stats->numIndexed, stats->numAliases, stats->sizedBlocks, stats->wastedBytes,
+            stats->lockAcquisitions, stats->lockContended);
+}
+
+/**
+ * @brief Print the fragmentation summary of one pool
+ * @param out Response stream (must not be NULL)
+ * @param name Pool name (must not be NULL)
+ * @param stats Snapshot of the pool (must not be NULL)
+ *
+ * External fragmentation is the share of free blocks outside the largest
+ * free run, i.e. how much of the free space a large request can't use.
+ */
+static void rma_introspectFrag(FILE *out, char const *name, struct rma_stats_t const *stats){
+    size_t const freeBlocks = stats->numBlocks > stats->numAllocated ? stats->numBlocks - stats->numAllocated : 0;
+    double const fragmentation = freeBlocks ? 100.0 * (double)(freeBlocks - stats->largestFreeRun) / (double)freeBlocks : 0.0;
+
+    fprintf(out, "%s free=%zu runs=%zu largest=%zu fragmentation=%.1f%%\n",
+            name, freeBlocks, stats->freeRuns, stats->largestFreeRun, fragmentation);
+}
+
+/**
+ * @brief Print the free-run histogram of one pool
+ * @param out Response stream (must not be NULL)
+ * @param name Pool name (must not be NULL)
+ * @param stats Snapshot of the pool (must not be NULL)
+ */
+static void rma_introspectHistogram(FILE *out, char const *name, struct rma_stats_t const *stats){
+    fprintf(out, "%s", name);
+    for (size_t bucket = 0; bucket < RMA_STATS_RUN_BUCKETS; bucket++){
+        if (stats->runHistogram[bucket]) fprintf(out, " %zu+=%zu", (size_t)1 << bucket, stats->runHistogram[bucket]);
+    }
+    fprintf(out, "\n");
+}
+
+/**
+ * @brief Print the request size histogram and internal fragmentation of one pool
+ * @param out Response stream (must not be NULL)
+ * @param name Pool name (must not be NULL)
+ * @param stats Snapshot of the pool (must not be NULL)
+ */
+static void rma_introspectSizes(FILE *out, char const *name, struct rma_stats_t const *stats){
+    size_t const sizedBytes = stats->sizedBlocks * stats->blockSize;
+    fprintf(out, "%s internal=%.1f%%", name, sizedBytes ? 100.0 * (double)stats->wastedBytes / (double)sizedBytes : 0.0);
+    for (size_t bucket = 0; bucket < RMA_STATS_SIZE_BUCKETS; bucket++){
+        if (stats->sizeHistogram[bucket]) fprintf(out, " %zu+=%zu", (size_t)1 << bucket, stats->sizeHistogram[bucket]);
+    }
+    fprintf(out, "\n");
+}
+
+/**
+ * @brief Write a copy of a pool to a new file in the snapshot directory
+ * @param header Pool to copy (must not be NULL)
+ * @param name Pool name, used in the file name (must not be NULL)
+ * @param path Output buffer receiving the file path
+ * @param size Size of the output buffer
+ * @return 1 on success, 0 on failure
+ */
+static int rma_introspectSnapshot(struct rma_mem_header_t *header, char const *name, char *path, size_t size){
+    // the name becomes a path component, so it must not leave the directory
+    if (strchr(name, '/') != NULL || name[0] == '.') return 0;
+
+    int const length = snprintf(path, size, "%s/%s.%zu.rma", rma_introspect.snapshotDir, name, ++rma_introspect.snapshots);
+    if (length < 0 || (size_t)length >= size) return 0;
+
+    struct rma_mem_header_t *clone = rma_clone(header);
+    if (clone == NULL) return 0;
+
+    // never replace or follow a link to a file that is already there
+    int const fd = open(path, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0600);
+    FILE *file = fd >= 0 ? fdopen(fd, "wb") : NULL;
+    if (file == NULL && fd >= 0) close(fd);
+
+    int written = file != NULL && fwrite(clone, 1, clone->totalSize, file) == clone->totalSize;
+    if (file != NULL && fclose(file) != 0) written = 0;
+
+    rma_destroy(clone);
+    return written;
+}
+
+/**
+ * @brief Run a request against one registered pool (rma_forEachPool() visitor)
+ * @param header Registered pool
+ * @param name Pool name
+ * @param context The struct rma_introspect_request_t being answered
+ */
+static void rma_introspectVisit(struct rma_mem_header_t *header, char const *name, void *context){
+    struct rma_introspect_request_t *request = context;
+    if (request->pool != NULL && strcmp(request->pool, name) != 0) return;
+    request->matched++;
+
+    char const *command = request->command;
+
+    if (!strcmp(command, "pools")){
+        fprintf(request->out, "%s\n", name);
+        return;
+    }
+
+    if (!strcmp(command, "stats") || !strcmp(command, "frag") || !strcmp(command, "histogram") || !strcmp(command, "sizes")){
+        struct rma_stats_t stats;
+        rma_getStats(header, &stats);
+
+        if (!strcmp(command, "stats")) rma_introspectStats(request->out, name, &stats);
+        else if (!strcmp(command, "sizes")) rma_introspectSizes(request->out, name, &stats);
+        else if (command[0] == 'f') rma_introspectFrag(request->out, name, &stats);
+        else rma_introspectHistogram(request->out, name, &stats);
+        return;
+    }
+
+    // everything else changes or copies the pool, which needs its lock
+    if (!header->options.threadSafe){
+        fprintf(request->out, "error %s: %s needs a threadSafe pool\n", name, command);
+        return;
+    }
+
+    if (!strcmp(command, "trim")){
+        fprintf(request->out, "%s trimmed=%zu\n", name, rma_trim(header));
+    }
+    else if (!strcmp(command, "compact")){
+        fprintf(request->out, "%s moved=%zu\n", name, rma_compact(header));
+    }
+    else if (!strcmp(command, "snapshot")){
+        char path[PATH_MAX];
+        if (rma_introspectSnapshot(header, name, path, sizeof(path))) fprintf(request->out, "%s snapshot=%s\n", name, path);
+        else fprintf(request->out, "error %s: snapshot failed\n", name);
+    }
+}
+
+/**
+ * @brief Answer one request line
+ * @param line Request, modified while being split into words (must not be NULL)
+ * @param out Response stream (must not be NULL)
+ */
+static void rma_introspectHandle(char *line, FILE *out){
+    char *save = NULL;
+    struct rma_introspect_request_t request = {
+        .command = strtok_r(line, " \t\r", &save),
+        .out = out
+    };
+    request.pool = strtok_r(NULL, " \t\r", &save);
+
+    char const *command = request.command;
+    if (command == NULL) return;
+
+    if (!strcmp(command, "help")){
+        fprintf(out, "help\npools\nstats [pool]\nfrag [pool]\nhistogram [pool]\nsizes [pool]\ntrim <pool>\ncompact <pool>\nsnapshot <pool>\n");
+        return;
+    }
+
+    int const query = !strcmp(command, "pools") || !strcmp(command, "stats") || !strcmp(command, "frag") || !strcmp(command, "histogram")
+        || !strcmp(command, "sizes");
+    int const action = !strcmp(command, "trim") || !strcmp(command, "compact") || !strcmp(command, "snapshot");
+
+    if (!query && !action){
+        fprintf(out, "error unknown command '%s'\n", command);
+        return;
+    }
+
+    // actions are too heavy to fan out by accident
+    if (action && request.pool == NULL){
+        fprintf(out, "error %s needs a pool name\n", command);
+        return;
+    }
+
+    // the destination is fixed by the process, never by the client
+    if (strtok_r(NULL, " \t\r", &save) != NULL){
+        fprintf(out, "error %s takes no further arguments\n", command);
+        return;
+    }
+    if (!strcmp(command, "snapshot") && rma_introspect.snapshotDir[0] == '\0'){
+        fprintf(out, "error snapshots are disabled\n");
+        return;
+    }
+
+    rma_forEachPool(rma_introspectVisit, &request);
+
+    if (request.pool != NULL && request.matched == 0) fprintf(out, "error no pool named '%s'\n", request.pool);
+}
+
+/**
+ * @brief Send a whole buffer to a client
+ * @param fd Client socket
+ * @param data Bytes to send
+ * @param size Number of bytes
+ * @return 1 on success, 0 if the client went away
+ */
+static int rma_introspectSend(int fd, char const *data, size_t size){
+    while (size > 0){
+        ssize_t const sent = send(fd, data, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return 0;
+
+        data += sent;
+        size -= (size_t)sent;
+    }
+    return 1;
+}
+
+/**
+ * @brief Read from a client and answer every complete line
+ * @param client Client with pending input (must not be NULL)
+ * @return 1 to keep the connection, 0 to close it
+ */
+static int rma_introspectServe(struct rma_introspect_client_t *client){
+    ssize_t const received = recv(client->fd, client->line + client->length, sizeof(client->line) - 1 - client->length, 0);
+    if (received < 0 && errno == EINTR) return 1;
+    if (received <= 0) return 0;
+    client->length += (size_t)received;
+
+    char *newline;
+    while ((newline = memchr(client->line, '\n', client->length)) != NULL){
+        *newline = '\0';
+
+        char *response = NULL;
+        size_t responseSize = 0;
+        FILE *out = open_memstream(&response, &responseSize);
+        if (out == NULL) return 0;
+
+        rma_introspectHandle(client->line, out);
+        fputc('\n', out); // the empty line ends the response
+        fclose(out);
+
+        int const sent = rma_introspectSend(client->fd, response, responseSize);
+        free(response);
+        if (!sent) return 0;
+
+        // keep whatever followed the line
+        size_t const consumed = (size_t)(newline - client->line) + 1;
+        memmove(client->line, newline + 1, client->length - consumed);
+        client->length -= consumed;
+    }
+
+    // a line that doesn't fit the buffer is a protocol error
+    return client->length < sizeof(client->line) - 1;
+}
+
+/**
+ * @brief Server thread: accept clients and answer their requests until stopped
+ * @param arg Unused
+ */
+static void* rma_introspectThread(void *arg){
+    (void)arg;
+
+    for (;;){
+        struct pollfd fds[RMA_INTROSPECT_MAX_CLIENTS + 2];
+        fds[0] = (struct pollfd){ .fd = rma_introspect.stopFd, .events = POLLIN };
+        fds[1] = (struct pollfd){ .fd = rma_introspect.listenFd, .events = POLLIN };
+        for (size_t i = 0; i < RMA_INTROSPECT_MAX_CLIENTS; i++){
+            fds[i + 2] = (struct pollfd){ .fd = rma_introspect.clients[i].fd, .events = POLLIN };
+        }
+
+        if (poll(fds, RMA_INTROSPECT_MAX_CLIENTS + 2, -1) < 0){
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[0].revents) break;
+
+        for (size_t i = 0; i < RMA_INTROSPECT_MAX_CLIENTS; i++){
+            struct rma_introspect_client_t *client = &rma_introspect.clients[i];
+            if (client->fd < 0 || !fds[i + 2].revents) continue;
+
+            if (!rma_introspectServe(client)){
+                close(client->fd);
+                client->fd = -1;
+                client->length = 0;
+            }
+        }
+
+        if (fds[1].revents & POLLIN){
+            int const fd = accept4(rma_introspect.listenFd, NULL, NULL, SOCK_CLOEXEC);
+            if (fd < 0) continue;
+
+            size_t slot = 0;
+            while (slot < RMA_INTROSPECT_MAX_CLIENTS && rma_introspect.clients[slot].fd >= 0) slot++;
+
+            if (slot == RMA_INTROSPECT_MAX_CLIENTS){
+                static char const busy[] = "error too many clients\n\n";
+                rma_introspectSend(fd, busy, sizeof(busy) - 1);
+                close(fd);
+            }
+            else {
+                rma_introspect.clients[slot].fd = fd;
+                rma_introspect.clients[slot].length = 0;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * FUNCTION DEFINITIONS
+ */
+
+int rma_introspectStart(char const *socketPath, char const *snapshotDir){
+    if (socketPath == NULL || rma_introspect.running) return 0;
+
+    struct sockaddr_un address = { .sun_family = AF_UNIX };
+    if (strlen(socketPath) >= sizeof(address.sun_path)) return 0;
+    strcpy(address.sun_path, socketPath);
+
+    struct stat status;
+    if (snapshotDir != NULL && (strlen(snapshotDir) >= sizeof(rma_introspect.snapshotDir) || stat(snapshotDir, &status) != 0 || !S_ISDIR(status.st_mode))){
+        return 0;
+    }
+
+    // a socket left behind by a previous run would make bind() fail, anything else there isn't ours to remove
+    if (lstat(socketPath, &status) == 0){
+        if (!S_ISSOCK(status.st_mode)) return 0;
+        unlink(socketPath);
+    }
+
+    int const listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) return 0;
+
+    if (bind(listenFd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(listenFd, RMA_INTROSPECT_MAX_CLIENTS) != 0){
+        close(listenFd);
+        return 0;
+    }
+
+    int const stopFd = eventfd(0, EFD_CLOEXEC);
+    if (stopFd < 0){
+        close(listenFd);
+        unlink(socketPath);
+        return 0;
+    }
+
+    rma_introspect.listenFd = listenFd;
+    rma_introspect.stopFd = stopFd;
+    rma_introspect.address = address;
+    snprintf(rma_introspect.snapshotDir, sizeof(rma_introspect.snapshotDir), "%s", snapshotDir != NULL ? snapshotDir : "");
+    rma_introspect.snapshots = 0;
+    for (size_t i = 0; i < RMA_INTROSPECT_MAX_CLIENTS; i++){
+        rma_introspect.clients[i].fd = -1;
+        rma_introspect.clients[i].length = 0;
+    }
+
+    if (pthread_create(&rma_introspect.thread, NULL, rma_introspectThread, NULL) != 0){
+        close(stopFd);
+        close(listenFd);
+        unlink(socketPath);
+        rma_introspect.listenFd = rma_introspect.stopFd = -1;
+        return 0;
+    }
+
+    rma_introspect.running = 1;
+    return 1;
+}
+
+void rma_introspectStop(void){
+    if (!rma_introspect.running) return;
+
+    uint64_t const wake = 1;
+    if (write(rma_introspect.stopFd, &wake, sizeof(wake)) != sizeof(wake)) return;
+    pthread_join(rma_introspect.thread, NULL);
+
+    for (size_t i = 0; i < RMA_INTROSPECT_MAX_CLIENTS; i++){
+        if (rma_introspect.clients[i].fd >= 0) close(rma_introspect.clients[i].fd);
+        rma_introspect.clients[i].fd = -1;
+    }
+
+    close(rma_introspect.listenFd);
+    close(rma_introspect.stopFd);
+    unlink(rma_introspect.address.sun_path);
+
+    rma_introspect.listenFd = rma_introspect.stopFd = -1;
+    rma_introspect.running = 0;
+}
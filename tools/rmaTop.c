@@ -0,0 +1,246 @@
+/**
+ * @file rmaTop.c
+ * @brief Live monitor of every published RMA pool on the host
+ * @author Robkoo
+ * @date 18.10.2026
+ * @version 0.0.3
+ * @since 0.0.3
+ *
+ * Maps the stats pages created by rma_publishStats() read-only and
+ * prints, once per interval, the claim/release rates, occupancy, free
+ * space fragmentation and allocation latency percentiles of every pool
+ * in every process. The monitored processes are never stopped or
+ * signalled; reading a page costs them nothing.
+ *
+ * Usage: rma-top [-i interval_ms] [-n refreshes]
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "memStatsPage.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/**
+ * @brief Maximum number of pools shown
+ */
+#define RMA_TOP_MAX_POOLS 256
+
+/**
+ * @brief Default refresh interval in milliseconds
+ */
+#define RMA_TOP_DEFAULT_INTERVAL 1000
+
+/**
+ * @brief Latest sample of one pool
+ */
+struct rma_top_pool_t {
+    char file[256];                  /**< Page file name inside RMA_STATS_PAGE_DIR */
+    struct rma_stats_page_t sample;  /**< Copy taken at this refresh */
+    struct rma_stats_page_t previous; /**< Copy taken at the previous refresh */
+    int hasPrevious;                 /**< Nonzero once two samples exist */
+};
+
+/**
+ * @brief Read one stats page file
+ * @param file File name inside RMA_STATS_PAGE_DIR (must not be NULL)
+ * @param copy Output copy (must not be NULL)
+ * @return 1 on success, 0 if the file is not a valid page
+ */
+static int rmaTopReadPage(char const *file, struct rma_stats_page_t *copy){
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", RMA_STATS_PAGE_DIR, file);
+
+    int const fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+
+    void *mapping = mmap(NULL, sizeof(struct rma_stats_page_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return 0;
+
+    int const ok = rma_readStatsPage(mapping, copy);
+    munmap(mapping, sizeof(struct rma_stats_page_t));
+    return ok;
+}
+
+/**
+ * @brief Refresh the samples of all pools with live owners
+ * @param pools Pool table, matched by file name across refreshes (must not be NULL)
+ * @param count In: pools from the last refresh, out: pools found now
+ * @param stale Output: pages whose owning process is gone
+ */
+static void rmaTopScan(struct rma_top_pool_t *pools, size_t *count, size_t *stale){
+    static struct rma_top_pool_t found[RMA_TOP_MAX_POOLS];
+    size_t numFound = 0;
+    *stale = 0;
+
+    DIR *directory = opendir(RMA_STATS_PAGE_DIR);
+    if (directory == NULL){
+        *count = 0;
+        return;
+    }
+
+    struct dirent *entry;
+    while ((entry = readdir(directory)) != NULL && numFound < RMA_TOP_MAX_POOLS){
+        if (strncmp(entry->d_name, RMA_STATS_PAGE_PREFIX, strlen(RMA_STATS_PAGE_PREFIX)) != 0) continue;
+
+        struct rma_top_pool_t *pool = &found[numFound];
+        if (!rmaTopReadPage(entry->d_name, &pool->sample)) continue;
+
+        // pages of crashed processes stay behind, don't show them as idle pools
+        if (kill(pool->sample.pid, 0) != 0 && errno == ESRCH){
+            (*stale)++;
+            continue;
+        }
+
+        snprintf(pool->file, sizeof(pool->file), "%s", entry->d_name);
+        pool->hasPrevious = 0;
+        for (size_t i = 0; i < *count; i++){
+            if (strcmp(pools[i].file, pool->file) != 0) continue;
+            pool->previous = pools[i].sample;
+            pool->hasPrevious = 1;
+            break;
+        }
+        numFound++;
+    }
+    closedir(directory);
+
+    memcpy(pools, found, numFound * sizeof(*pools));
+    *count = numFound;
+}
+
+/**
+ * @brief Latency below which a given share of allocation calls finished
+ * @param pool Pool with its current and (optionally) previous sample
+ * @param quantile Share of calls, e.g. 0.99
+ * @return Upper bound of the matching latency bucket in ns, or 0 without calls
+ *
+ * Uses the calls of the last interval when there were any, the whole
+ * history otherwise.
+ */
+static uint64_t rmaTopPercentile(struct rma_top_pool_t const *pool, double quantile){
+    uint64_t counts[RMA_LATENCY_BUCKETS];
+    uint64_t total = 0;
+
+    for (int pass = 0; pass < 2 && total == 0; pass++){
+        int const delta = pass == 0 && pool->hasPrevious;
+        for (size_t bucket = 0; bucket < RMA_LATENCY_BUCKETS; bucket++){
+            counts[bucket] = pool->sample.latency[bucket] - (delta ? pool->previous.latency[bucket] : 0);
+            total += counts[bucket];
+        }
+    }
+    if (total == 0) return 0;
+
+    uint64_t const target = (uint64_t)((double)total * quantile);
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < RMA_LATENCY_BUCKETS; bucket++){
+        seen += counts[bucket];
+        if (seen > target) return (uint64_t)2 << bucket;
+    }
+    return (uint64_t)2 << (RMA_LATENCY_BUCKETS - 1);
+}
+
+/**
+ * @brief Format a latency for the table
+ * @param ns Latency in nanoseconds (0 = no data)
+ * @param text Output buffer
+ * @param size Size of the output buffer
+ */
+static void rmaTopFormatNs(uint64_t ns, char *text, size_t size){
+    if (ns == 0) snprintf(text, size, "-");
+    else if (ns < 1000) snprintf(text, size, "%lluns", (unsigned long long)ns);
+    else if (ns < 1000000) snprintf(text, size, "%.1fus", (double)ns / 1e3);
+    else snprintf(text, size, "%.1fms", (double)ns / 1e6);
+}
+
+/**
+ * @brief Print one refresh
+ * @param pools Current samples
+ * @param count Number of pools
+ * @param stale Number of stale pages skipped
+ * @param seconds Length of the interval the rates cover
+ */
+static void rmaTopPrint(struct rma_top_pool_t const *pools, size_t count, size_t stale, double seconds){
+    if (isatty(STDOUT_FILENO)) printf("\033[H\033[J");
+
+    printf("rma-top - %zu pools", count);
+    if (stale) printf(", %zu stale pages in %s", stale, RMA_STATS_PAGE_DIR);
+    printf("\n\n%8s %-20s %10s %7s %10s %10s %7s %8s %8s %8s\n",
+           "PID", "POOL", "BLOCKS", "USED%", "ALLOC/s", "FREE/s", "FRAG%", "p50", "p99", "p99.9");
+
+    for (size_t i = 0; i < count; i++){
+        struct rma_stats_page_t const *now = &pools[i].sample;
+        struct rma_stats_page_t const *before = &pools[i].previous;
+
+        double const used = now->numBlocks ? 100.0 * (double)now->numAllocated / (double)now->numBlocks : 0.0;
+        uint64_t const freeBlocks = now->numBlocks > now->numAllocated ? now->numBlocks - now->numAllocated : 0;
+        double const fragmentation = freeBlocks && now->largestFreeRun <= freeBlocks ?
+            100.0 * (double)(freeBlocks - now->largestFreeRun) / (double)freeBlocks : 0.0;
+
+        char allocRate[16] = "-", freeRate[16] = "-";
+        if (pools[i].hasPrevious){
+            snprintf(allocRate, sizeof(allocRate), "%.0f", (double)(now->allocs - before->allocs) / seconds);
+            snprintf(freeRate, sizeof(freeRate), "%.0f", (double)(now->frees - before->frees) / seconds);
+        }
+
+        char p50[16], p99[16], p999[16];
+        rmaTopFormatNs(rmaTopPercentile(&pools[i], 0.5), p50, sizeof(p50));
+        rmaTopFormatNs(rmaTopPercentile(&pools[i], 0.99), p99, sizeof(p99));
+        rmaTopFormatNs(rmaTopPercentile(&pools[i], 0.999), p999, sizeof(p999));
+
+        printf("%8d %-20s %10llu %6.1f%% %10s %10s %6.1f%% %8s %8s %8s\n",
+               now->pid, now->name, (unsigned long long)now->numBlocks, used, allocRate, freeRate, fragmentation, p50, p99, p999);
+    }
+
+    fflush(stdout);
+}
+
+/**
+ * @brief Entry point of rma-top
+ * @param argc Argument count
+ * @param argv Arguments
+ * @return 0 on success, 1 on usage errors
+ */
+int main(int argc, char **argv){
+    long interval = RMA_TOP_DEFAULT_INTERVAL;
+    long refreshes = 0; // 0 = until interrupted
+
+    int option;
+    while ((option = getopt(argc, argv, "i:n:h")) != -1){
+        switch (option){
+            case 'i': interval = strtol(optarg, NULL, 10); break;
+            case 'n': refreshes = strtol(optarg, NULL, 10); break;
+            default:
+                fprintf(stderr, "usage: %s [-i interval_ms] [-n refreshes]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (interval <= 0 || refreshes < 0){
+        fprintf(stderr, "%s: interval must be positive and refreshes non-negative\n", argv[0]);
+        return 1;
+    }
+
+    static struct rma_top_pool_t pools[RMA_TOP_MAX_POOLS];
+    size_t count = 0, stale = 0;
+
+    // the first scan only provides the baseline for the rates
+    rmaTopScan(pools, &count, &stale);
+
+    struct timespec const delay = { interval / 1000, (interval % 1000) * 1000000 };
+    for (long shown = 0; refreshes == 0 || shown < refreshes; shown++){
+        nanosleep(&delay, NULL);
+        rmaTopScan(pools, &count, &stale);
+        rmaTopPrint(pools, count, stale, (double)interval / 1000.0);
+    }
+
+    return 0;
+}
@@ -0,0 +1,563 @@
+/**
+ * @file rmaTune.c
+ * @brief Offline block size / pool size tuner driven by allocation traces
+ * @author Robkoo
+ * @date 18.10.2026
+ * @version 0.0.3
+ * @since 0.0.3
+ *
+ * Reads a recorded allocation trace, simulates every candidate
+ * (blockSize, headroom) configuration against the library's own layout
+ * math (rma_computeLayout()), replays a sample of the trace on a real pool
+ * to measure alloc/free latency, and recommends the configuration that
+ * needs the least memory while meeting the latency target. The result is
+ * written as a config file the library can load.
+ *
+ * Trace format (one event per line, chronological, '#' starts a comment):
+ *
+ *     a <id> <size> [thread]    allocation of <size> bytes named <id>
+ *     f <id> [thread]           free of the allocation named <id>
+ *
+ * Ids only need to be unique among live allocations. Lifetimes are
+ * implied by the a/f pairs; when the optional thread column names more
+ * than one thread, candidates are replayed on a threadSafe pool so the
+ * measured latency includes the pool lock, and the recommendation enables
+ * threadSafe. Requests larger than blockSize are modelled as
+ * ceil(size / blockSize) blocks, since RMA hands out fixed-size blocks.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "memHeader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief Maximum number of candidate block sizes or headroom values
+ */
+#define RMA_TUNE_MAX_CANDIDATES 32
+
+/**
+ * @brief Default number of events replayed on a real pool per candidate
+ *
+ * Allocation in RMA is O(n) in the block count, so replaying huge traces
+ * for every candidate is slow. The layout simulation always covers the
+ * whole trace; only the latency measurement is sampled.
+ */
+#define RMA_TUNE_DEFAULT_SAMPLE 200000
+
+/**
+ * @brief One parsed trace event
+ */
+struct rma_tune_event_t {
+    size_t slot;     /**< Allocation slot this event refers to */
+    size_t size;     /**< Requested size in bytes (allocations only) */
+    int isAlloc;     /**< 1 for allocation, 0 for free */
+};
+
+/**
+ * @brief Whole parsed trace plus derived statistics
+ */
+struct rma_tune_trace_t {
+    struct rma_tune_event_t *events; /**< Events in chronological order */
+    size_t numEvents;                /**< Number of valid events */
+    size_t *slotSizes;               /**< Requested size per allocation slot */
+    size_t numSlots;                 /**< Number of allocations in the trace */
+    size_t numThreads;               /**< Distinct thread ids seen */
+    size_t unmatchedFrees;           /**< Frees without a live allocation */
+};
+
+/**
+ * @brief Result of evaluating one candidate configuration
+ */
+struct rma_tune_result_t {
+    size_t blockSize;     /**< Candidate block size in bytes */
+    unsigned headroom;    /**< Extra blocks over the peak, in percent */
+    size_t peakBlocks;    /**< Peak live blocks over the whole trace */
+    size_t totalSize;     /**< Pool size needed for peak + headroom */
+    size_t wastedBytes;   /**< Internal fragmentation at the peak */
+    double latencyNs;     /**< Mean alloc/free latency in nanoseconds */
+    size_t failedAllocs;  /**< rma_alloc() failures during the replay */
+    int threadSafe;       /**< Replayed (and recommended) with options.threadSafe */
+};
+
+/**
+ * STATIC HELPER FUNCTIONS
+ */
+
+/**
+ * @brief Tiny open-addressing map from 64-bit ids to allocation slots
+ *
+ * Used only while parsing; slots are the index of the allocation event.
+ */
+struct rma_tune_map_t {
+    uint64_t *keys;   /**< Stored ids */
+    size_t *values;   /**< Slot per id, SIZE_MAX = empty entry */
+    size_t capacity;  /**< Power of two capacity */
+    size_t count;     /**< Occupied entries (including tombstones) */
+};
+
+static size_t rma_tuneHash(uint64_t key, size_t capacity){
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (size_t)key & (capacity - 1);
+}
+
+static int rma_tuneMapInit(struct rma_tune_map_t *map, size_t capacity){
+    map->capacity = capacity;
+    map->count = 0;
+    map->keys = calloc(capacity, sizeof(uint64_t));
+    map->values = malloc(capacity * sizeof(size_t));
+    if (!map->keys || !map->values) return 0;
+    for (size_t i = 0; i < capacity; i++) map->values[i] = SIZE_MAX;
+    return 1;
+}
+
+static void rma_tuneMapFree(struct rma_tune_map_t *map){
+    free(map->keys);
+    free(map->values);
+}
+
+static int rma_tuneMapPut(struct rma_tune_map_t *map, uint64_t key, size_t value);
+
+static int rma_tuneMapGrow(struct rma_tune_map_t *map){
+    struct rma_tune_map_t bigger;
+    if (!rma_tuneMapInit(&bigger, map->capacity * 2)){
+        rma_tuneMapFree(&bigger);
+        return 0;
+    }
+
+    // SIZE_MAX - 1 marks a tombstone, those are dropped while rehashing
+    for (size_t i = 0; i < map->capacity; i++){
+        if (map->values[i] < SIZE_MAX - 1) rma_tuneMapPut(&bigger, map->keys[i], map->values[i]);
+    }
+
+    free(map->keys);
+    free(map->values);
+    *map = bigger;
+    return 1;
+}
+
+static int rma_tuneMapPut(struct rma_tune_map_t *map, uint64_t key, size_t value){
+    if ((map->count + 1) * 2 > map->capacity && !rma_tuneMapGrow(map)) return 0;
+
+    size_t i = rma_tuneHash(key, map->capacity);
+    while (map->values[i] != SIZE_MAX){
+        if (map->values[i] != SIZE_MAX - 1 && map->keys[i] == key) break;
+        i = (i + 1) & (map->capacity - 1);
+    }
+
+    if (map->values[i] == SIZE_MAX) map->count++;
+    map->keys[i] = key;
+    map->values[i] = value;
+    return 1;
+}
+
+static size_t rma_tuneMapFind(struct rma_tune_map_t const *map, uint64_t key){
+    size_t i = rma_tuneHash(key, map->capacity);
+    while (map->values[i] != SIZE_MAX){
+        if (map->values[i] != SIZE_MAX - 1 && map->keys[i] == key) return map->values[i];
+        i = (i + 1) & (map->capacity - 1);
+    }
+    return SIZE_MAX;
+}
+
+static size_t rma_tuneMapTake(struct rma_tune_map_t *map, uint64_t key){
+    size_t i = rma_tuneHash(key, map->capacity);
+    while (map->values[i] != SIZE_MAX){
+        if (map->values[i] != SIZE_MAX - 1 && map->keys[i] == key){
+            size_t const value = map->values[i];
+            map->values[i] = SIZE_MAX - 1; // leave a tombstone
+            return value;
+        }
+        i = (i + 1) & (map->capacity - 1);
+    }
+    return SIZE_MAX;
+}
+
+/**
+ * @brief Release the arrays of a loaded trace
+ */
+static void rma_tuneFreeTrace(struct rma_tune_trace_t *trace){
+    free(trace->events);
+    free(trace->slotSizes);
+    trace->events = NULL;
+    trace->slotSizes = NULL;
+}
+
+/**
+ * @brief Parse a comma separated list of sizes into an array
+ * @return Number of parsed values, 0 on error
+ */
+static size_t rma_tuneParseList(char const *text, size_t *out, size_t maxOut){
+    size_t count = 0;
+    char const *cursor = text;
+
+    while (*cursor && count < maxOut){
+        char *end = NULL;
+        unsigned long long const value = strtoull(cursor, &end, 0);
+        if (end == cursor) return 0;
+        out[count++] = (size_t)value;
+        cursor = (*end == ',') ? end + 1 : end;
+        if (*end && *end != ',') return 0;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Load and index a trace file
+ * @return 1 on success, 0 on failure (message already printed)
+ */
+static int rma_tuneLoadTrace(char const *path, struct rma_tune_trace_t *trace){
+    FILE *file = fopen(path, "r");
+    if (!file){
+        fprintf(stderr, "rma-tune: cannot open trace '%s'\n", path);
+        return 0;
+    }
+
+    size_t eventCapacity = 1024, slotCapacity = 1024;
+    trace->events = malloc(eventCapacity * sizeof(*trace->events));
+    trace->slotSizes = malloc(slotCapacity * sizeof(size_t));
+
+    // thread ids are only counted, so a small set is enough
+    struct rma_tune_map_t live = {0}, threads = {0};
+    int const mapsReady = rma_tuneMapInit(&live, 1024) & rma_tuneMapInit(&threads, 64);
+    if (!trace->events || !trace->slotSizes || !mapsReady){
+        fprintf(stderr, "rma-tune: out of memory\n");
+        rma_tuneMapFree(&live);
+        rma_tuneMapFree(&threads);
+        rma_tuneFreeTrace(trace);
+        fclose(file);
+        return 0;
+    }
+
+    char line[256];
+    size_t lineNumber = 0;
+    int loaded = 1;
+    while (loaded && fgets(line, sizeof(line), file)){
+        lineNumber++;
+
+        char kind = 0;
+        unsigned long long id = 0, size = 0, thread = 0;
+        int fields = 0;
+
+        if (line[0] == '#' || line[0] == '\n') continue;
+        if (line[0] == 'a') fields = sscanf(line, " %c %llu %llu %llu", &kind, &id, &size, &thread);
+        else if (line[0] == 'f') fields = sscanf(line, " %c %llu %llu", &kind, &id, &thread);
+
+        if ((kind == 'a' && fields < 3) || (kind == 'f' && fields < 2) || kind == 0){
+            fprintf(stderr, "rma-tune: %s:%zu: malformed event ignored\n", path, lineNumber);
+            continue;
+        }
+
+        if ((kind == 'a' && fields == 4) || (kind == 'f' && fields == 3)){
+            if (rma_tuneMapFind(&threads, thread) == SIZE_MAX){
+                trace->numThreads++;
+                if (!rma_tuneMapPut(&threads, thread, 0)){
+                    loaded = 0;
+                    break;
+                }
+            }
+        }
+
+        struct rma_tune_event_t event = {0};
+        if (kind == 'a'){
+            if (trace->numSlots == slotCapacity){
+                slotCapacity *= 2;
+                size_t *grown = realloc(trace->slotSizes, slotCapacity * sizeof(size_t));
+                if (!grown){
+                    loaded = 0;
+                    break;
+                }
+                trace->slotSizes = grown;
+            }
+            event.isAlloc = 1;
+            event.size = (size_t)size;
+            event.slot = trace->numSlots;
+            trace->slotSizes[trace->numSlots++] = (size_t)size;
+            if (!rma_tuneMapPut(&live, id, event.slot)){
+                loaded = 0;
+                break;
+            }
+        }
+        else {
+            event.slot = rma_tuneMapTake(&live, id);
+            if (event.slot == SIZE_MAX){
+                trace->unmatchedFrees++;
+                continue;
+            }
+        }
+
+        if (trace->numEvents == eventCapacity){
+            eventCapacity *= 2;
+            struct rma_tune_event_t *grown = realloc(trace->events, eventCapacity * sizeof(*grown));
+            if (!grown){
+                loaded = 0;
+                break;
+            }
+            trace->events = grown;
+        }
+        trace->events[trace->numEvents++] = event;
+    }
+
+    // a truncated trace would yield a recommendation that looks valid
+    if (loaded && ferror(file)){
+        fprintf(stderr, "rma-tune: error reading trace '%s'\n", path);
+        loaded = 0;
+    }
+    else if (!loaded) fprintf(stderr, "rma-tune: %s:%zu: out of memory\n", path, lineNumber);
+
+    rma_tuneMapFree(&live);
+    rma_tuneMapFree(&threads);
+    fclose(file);
+    if (!loaded) rma_tuneFreeTrace(trace);
+    return loaded;
+}
+
+/**
+ * @brief Blocks needed to hold a request of the given size
+ */
+static size_t rma_tuneBlocksFor(size_t size, size_t blockSize){
+    return size == 0 ? 1 : (size + blockSize - 1) / blockSize;
+}
+
+/**
+ * @brief Walk the whole trace and compute peak live blocks and waste at peak
+ */
+static void rma_tuneSimulate(struct rma_tune_trace_t const *trace, struct rma_tune_result_t *result){
+    size_t liveBlocks = 0, liveWaste = 0;
+    result->peakBlocks = 0;
+    result->wastedBytes = 0;
+
+    for (size_t i = 0; i < trace->numEvents; i++){
+        struct rma_tune_event_t const *event = &trace->events[i];
+        size_t const size = trace->slotSizes[event->slot];
+        size_t const blocks = rma_tuneBlocksFor(size, result->blockSize);
+        size_t const waste = blocks * result->blockSize - size;
+
+        if (event->isAlloc){
+            liveBlocks += blocks;
+            liveWaste += waste;
+            if (liveBlocks > result->peakBlocks){
+                result->peakBlocks = liveBlocks;
+                result->wastedBytes = liveWaste;
+            }
+        }
+        else {
+            liveBlocks -= blocks;
+            liveWaste -= waste;
+        }
+    }
+}
+
+/**
+ * @brief Replay the first sampleEvents events on a real pool and time them
+ * @return Mean nanoseconds per alloc/free call, or -1.0 on failure
+ *
+ * Allocation failures (e.g. salt exhaustion on very dense pools) are
+ * counted into result->failedAllocs so the candidate can be rejected.
+ */
+static double rma_tuneReplay(struct rma_tune_trace_t const *trace, struct rma_tune_result_t *result, size_t sampleEvents){
+    size_t const events = trace->numEvents < sampleEvents ? trace->numEvents : sampleEvents;
+
+    // every allocation slot gets a contiguous run of handle entries
+    size_t *firstHandle = malloc((trace->numSlots + 1) * sizeof(size_t));
+    if (!firstHandle) return -1.0;
+
+    size_t totalHandles = 0;
+    for (size_t slot = 0; slot < trace->numSlots; slot++){
+        firstHandle[slot] = totalHandles;
+        totalHandles += rma_tuneBlocksFor(trace->slotSizes[slot], result->blockSize);
+    }
+    firstHandle[trace->numSlots] = totalHandles;
+
+    struct rma_options_t const options = { .threadSafe = result->threadSafe };
+    rma_handle_t *handles = malloc((totalHandles ? totalHandles : 1) * sizeof(rma_handle_t));
+    struct rma_mem_header_t *pool = rma_memHeaderInitEx(result->totalSize, result->blockSize, &options);
+    if (!handles || !pool){
+        free(firstHandle);
+        free(handles);
+        rma_destroy(pool);
+        return -1.0;
+    }
+
+    size_t calls = 0;
+    result->failedAllocs = 0;
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (size_t i = 0; i < events; i++){
+        struct rma_tune_event_t const *event = &trace->events[i];
+        size_t const from = firstHandle[event->slot];
+        size_t const to = firstHandle[event->slot + 1];
+
+        for (size_t h = from; h < to; h++){
+            if (event->isAlloc){
+                handles[h] = rma_alloc(pool);
+                if (handles[h] == RMA_INVALID_HANDLE) result->failedAllocs++;
+            }
+            else {
+                rma_free(pool, handles[h]);
+            }
+            calls++;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    free(firstHandle);
+    free(handles);
+    rma_destroy(pool);
+
+    double const elapsedNs = (double)(end.tv_sec - start.tv_sec) * 1e9 + (double)(end.tv_nsec - start.tv_nsec);
+    return calls > 0 ? elapsedNs / (double)calls : 0.0;
+}
+
+/**
+ * @brief Write the recommended configuration in the library's config format
+ * @return 1 on success, 0 on failure
+ */
+static int rma_tuneWriteConfig(char const *path, char const *tracePath, struct rma_tune_result_t const *best, double targetNs){
+    FILE *file = fopen(path, "w");
+    if (!file) return 0;
+
+    fprintf(file, "# Generated by rma-tune from '%s'\n", tracePath);
+    fprintf(file, "# peak live blocks %zu, headroom %u%%, mean latency %.1f ns (target %.1f ns)\n",
+            best->peakBlocks, best->headroom, best->latencyNs, targetNs);
+    fprintf(file, "totalSize = %zu\n", best->totalSize);
+    fprintf(file, "blockSize = %zu\n", best->blockSize);
+    if (best->threadSafe) fprintf(file, "threadSafe = 1\n");
+
+    return fclose(file) == 0;
+}
+
+static void rma_tuneUsage(void){
+    fprintf(stderr,
+        "Usage: rma-tune [options] <trace>\n"
+        "  -l <ns>      target mean alloc/free latency in nanoseconds (default 1000)\n"
+        "  -b <list>    comma separated candidate block sizes (default 16,32,...,65536)\n"
+        "  -H <list>    comma separated headroom percentages (default 0,25,50,100)\n"
+        "  -s <events>  events replayed per candidate for latency (default %d)\n"
+        "  -o <file>    output config file (default rma.conf)\n",
+        RMA_TUNE_DEFAULT_SAMPLE);
+}
+
+/**
+ * @brief Entry point of the rma-tune tool
+ * @return 0 on success, 1 on failure
+ */
+int main(int argc, char **argv){
+    double targetNs = 1000.0;
+    size_t sampleEvents = RMA_TUNE_DEFAULT_SAMPLE;
+    char const *outPath = "rma.conf";
+
+    size_t blockSizes[RMA_TUNE_MAX_CANDIDATES];
+    size_t numBlockSizes = 0;
+    for (size_t size = 16; size <= 65536; size *= 2) blockSizes[numBlockSizes++] = size;
+
+    size_t headrooms[RMA_TUNE_MAX_CANDIDATES] = {0, 25, 50, 100};
+    size_t numHeadrooms = 4;
+
+    int option;
+    while ((option = getopt(argc, argv, "l:b:H:s:o:h")) != -1){
+        switch (option){
+            case 'l': targetNs = strtod(optarg, NULL); break;
+            case 'b': numBlockSizes = rma_tuneParseList(optarg, blockSizes, RMA_TUNE_MAX_CANDIDATES); break;
+            case 'H': numHeadrooms = rma_tuneParseList(optarg, headrooms, RMA_TUNE_MAX_CANDIDATES); break;
+            case 's': sampleEvents = strtoull(optarg, NULL, 0); break;
+            case 'o': outPath = optarg; break;
+            default: rma_tuneUsage(); return 1;
+        }
+    }
+
+    if (optind != argc - 1 || numBlockSizes == 0 || numHeadrooms == 0){
+        rma_tuneUsage();
+        return 1;
+    }
+
+    struct rma_tune_trace_t trace = {0};
+    if (!rma_tuneLoadTrace(argv[optind], &trace)) return 1;
+    if (trace.numSlots == 0){
+        fprintf(stderr, "rma-tune: trace contains no allocations\n");
+        rma_tuneFreeTrace(&trace);
+        return 1;
+    }
+
+    // allocations from several threads need the pool lock, so it is part of every measurement
+    struct rma_options_t const options = { .threadSafe = trace.numThreads > 1 };
+
+    // salts in rma_alloc() come from rand()
+    srand((unsigned)time(NULL));
+
+    printf("Trace: %zu events, %zu allocations, %zu threads, %zu unmatched frees\n\n",
+           trace.numEvents, trace.numSlots, trace.numThreads, trace.unmatchedFrees);
+    printf("%10s %9s %12s %14s %14s %12s %8s\n", "blockSize", "headroom", "peakBlocks", "totalSize", "wastedAtPeak", "latency(ns)", "failed");
+
+    struct rma_tune_result_t best = {0};
+    struct rma_tune_result_t fastest = {0};
+    int haveBest = 0, haveFastest = 0;
+
+    for (size_t b = 0; b < numBlockSizes; b++){
+        struct rma_tune_result_t result = { .blockSize = blockSizes[b], .threadSafe = options.threadSafe };
+        if (result.blockSize == 0) continue;
+        rma_tuneSimulate(&trace, &result);
+
+        for (size_t h = 0; h < numHeadrooms; h++){
+            result.headroom = (unsigned)headrooms[h];
+
+            size_t const blocks = result.peakBlocks + (result.peakBlocks * result.headroom + 99) / 100;
+            result.totalSize = rma_poolSizeForBlocks(blocks ? blocks : 1, result.blockSize, &options);
+            if (result.totalSize == 0) continue;
+
+            result.latencyNs = rma_tuneReplay(&trace, &result, sampleEvents);
+            if (result.latencyNs < 0.0) continue;
+
+            printf("%10zu %8u%% %12zu %14zu %14zu %12.1f %8zu\n", result.blockSize, result.headroom,
+                   result.peakBlocks, result.totalSize, result.wastedBytes, result.latencyNs, result.failedAllocs);
+
+            // a configuration that cannot serve the trace is never recommended
+            if (result.failedAllocs > 0) continue;
+
+            if (!haveFastest || result.latencyNs < fastest.latencyNs){
+                fastest = result;
+                haveFastest = 1;
+            }
+            if (result.latencyNs <= targetNs &&
+                (!haveBest || result.totalSize < best.totalSize ||
+                 (result.totalSize == best.totalSize && result.latencyNs < best.latencyNs))){
+                best = result;
+                haveBest = 1;
+            }
+        }
+    }
+
+    if (!haveFastest){
+        fprintf(stderr, "rma-tune: no candidate configuration could be evaluated\n");
+        rma_tuneFreeTrace(&trace);
+        return 1;
+    }
+
+    if (!haveBest){
+        printf("\nNo candidate meets %.1f ns, falling back to the fastest one.\n", targetNs);
+        best = fastest;
+    }
+
+    printf("\nRecommended: blockSize = %zu, totalSize = %zu%s (%.1f ns)\n", best.blockSize, best.totalSize,
+           best.threadSafe ? ", threadSafe" : "", best.latencyNs);
+
+    int const written = rma_tuneWriteConfig(outPath, argv[optind], &best, targetNs);
+    rma_tuneFreeTrace(&trace);
+    if (!written){
+        fprintf(stderr, "rma-tune: cannot write '%s'\n", outPath);
+        return 1;
+    }
+    printf("Config written to %s\n", outPath);
+
+    return 0;
+}